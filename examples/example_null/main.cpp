@@ -2,11 +2,50 @@
 // (compile and link imgui, create context, run headless with NO INPUTS, NO GRAPHICS OUTPUT)
 // This is useful to test building, but you cannot interact with anything here!
 #include "imgui.h"
+#include "../../misc/cpp/imgui_stdlib.h"
 #include <stdio.h>
+#include <stdlib.h>
+
+// Count heap allocations made by dear imgui, for the self-test below
+static int AllocCount = 0;
+static void* CountingMalloc(size_t sz, void*) { AllocCount++; return malloc(sz); }
+static void CountingFree(void* ptr, void*) { free(ptr); }
+
+// Self-test: an active InputText() on a std::string makes no heap allocation on idle frames,
+// neither from dear imgui nor by reallocating the string (its buffer pointer stays the same).
+static bool TestInputTextIdleAllocations()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    static std::string str = "Hello, world!";
+    const char* str_data = NULL;
+    int frame_allocs = 0;
+    for (int n = 0; n < 10; n++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        const int alloc_count = AllocCount;
+        ImGui::Begin("InputText allocations test");
+        if (n == 0)
+            ImGui::SetKeyboardFocusHere();
+        ImGui::InputText("std::string", &str, ImGuiInputTextFlags_ApplyOnEditOnly);
+        ImGui::End();
+        if (n >= 5) // Warmed up: the field is active and its state allocated
+        {
+            frame_allocs += AllocCount - alloc_count;
+            if (str_data != NULL && str_data != str.c_str())
+                frame_allocs++;
+            str_data = str.c_str();
+        }
+        ImGui::Render();
+    }
+    printf("InputText() idle allocations: %d\n", frame_allocs);
+    return frame_allocs == 0 && ImGui::IsAnyItemActive();
+}
 
 int main(int, char**)
 {
     IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(CountingMalloc, CountingFree);
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
 
@@ -31,7 +70,9 @@ int main(int, char**)
         ImGui::Render();
     }
 
+    const bool test_ok = TestInputTextIdleAllocations();
+
     printf("DestroyContext()\n");
     ImGui::DestroyContext();
-    return 0;
+    return test_ok ? 0 : 1;
 }
@@ -41,6 +41,8 @@
 //#define IMGUI_DISABLE_DEFAULT_MATH_FUNCTIONS              // Don't implement ImFabs/ImSqrt/ImPow/ImFmod/ImCos/ImSin/ImAcos/ImAtan2 so you can implement them yourself.
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
+//#define IMGUI_DISABLE_FRAME_ARENA                         // Don't serve transient allocations (clipboard copies, conversion scratch..) from the per-frame arena, use MemAlloc()/MemFree() for each of them instead.
+//#define IMGUI_DISABLE_SSE                                 // Don't use SSE2 intrinsics (otherwise used when the compiler targets it, e.g. to scan large plots).
 
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
@@ -96,6 +98,10 @@
 //---- Debug Tools: Enable slower asserts
 //#define IMGUI_DEBUG_PARANOID
 
+//---- Debug Tools: Account allocations per subsystem (draw lists, windows, fonts, settings..), see GetMemTagStats() and Metrics->Memory.
+// This adds a 16 bytes header to every allocation.
+//#define IMGUI_ENABLE_MEMORY_TAGS
+
 //---- Tip: You can add extra functions within the ImGui:: namespace, here or in your own headers files.
 /*
 namespace ImGui
@@ -60,6 +60,7 @@ CODE
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextLog
 // [SECTION] ImGuiListClipper
 // [SECTION] RENDER HELPERS
 // [SECTION] MAIN CODE (most of the code! lots of stuff, needs tidying up!)
@@ -858,6 +859,7 @@ static const float NAV_WINDOWING_LIST_APPEAR_DELAY          = 0.15f;    // Time
 static const float WINDOWS_RESIZE_FROM_EDGES_HALF_THICKNESS = 4.0f;     // Extend outside and inside windows. Affect FindHoveredWindow().
 static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduce visual noise by only highlighting the border after a certain time.
 static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 2.00f;    // Lock scrolled window (so it doesn't pick child windows that are scrolling through) for a certaint time, unless mouse moved.
+static const float WINDOWS_MEMORY_SHRINK_TIMER              = 10.0f;    // Period over which we track the high water mark of window draw lists, shrink those which are more than twice larger.
 
 //-------------------------------------------------------------------------
 // [SECTION] FORWARD DECLARATIONS
@@ -876,7 +878,16 @@ static ImRect           GetViewportRect();
 // Settings
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
 static void             WindowSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
+static bool             WindowSettingsHandler_UpdateSettings(ImGuiContext* ctx);
 static void             WindowSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler*, ImGuiTextBuffer* buf);
+static void             WindowSettingsHandler_ReadBinary(ImGuiContext*, ImGuiSettingsHandler*, const char* data, const char* data_end);
+static void             WindowSettingsHandler_WriteBinary(ImGuiContext*, ImGuiSettingsHandler*, ImVector<char>* buf);
+static void*            DataTableSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
+static void             DataTableSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
+static void             DataTableSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler*, ImGuiTextBuffer* buf);
+static void             SettingsSaveTaskWrite(ImGuiSettingsSaveTask* task);
+static void             SettingsSaveTaskFunc(void* task_data);
+static bool             UpdateSettingsSaveTask(ImGuiContext* ctx, bool wait);
 
 // Platform Dependents default implementation for IO functions
 static const char*      GetClipboardTextFn_DefaultImpl(void* user_data);
@@ -951,6 +962,26 @@ static void*  (*GImAllocatorAllocFunc)(size_t size, void* user_data) = MallocWra
 static void   (*GImAllocatorFreeFunc)(void* ptr, void* user_data) = FreeWrapper;
 static void*    GImAllocatorUserData = NULL;
 
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+// Allocations are prefixed with a header holding their size and tag. Using 16 bytes preserves the alignment given by the allocator.
+struct ImGuiMemAllocHeader
+{
+    size_t          Size;
+    ImGuiMemTag     Tag;
+};
+static const size_t     IM_MEM_ALLOC_HEADER_SIZE = 16;
+
+// MemAlloc() may be called from other threads (ImFontAtlas::BuildParallelFor tasks, ImGuiIO::IniSaveAsync tasks):
+// each thread has its own current tag, and the stats are updated with atomic operations.
+#if defined(_MSC_VER)
+#define IM_THREAD_LOCAL         __declspec(thread)
+#else
+#define IM_THREAD_LOCAL         __thread
+#endif
+static ImGuiMemTagStats                 GImMemTagStats[ImGuiMemTag_COUNT];
+static IM_THREAD_LOCAL ImGuiMemTag      GImMemTagCurrent = ImGuiMemTag_Other;
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] MAIN USER FACING STRUCTURES (ImGuiStyle, ImGuiIO)
 //-----------------------------------------------------------------------------
@@ -1036,6 +1067,9 @@ ImGuiIO::ImGuiIO()
     DeltaTime = 1.0f/60.0f;
     IniSavingRate = 5.0f;
     IniFilename = "imgui.ini";
+    IniSaveBinary = false;
+    IniSaveAsync = NULL;
+    IniSaveAsyncUserData = NULL;
     LogFilename = "imgui_log.txt";
     MouseDoubleClickTime = 0.30f;
     MouseDoubleClickMaxDist = 6.0f;
@@ -1059,6 +1093,8 @@ ImGuiIO::ImGuiIO()
     ConfigMacOSXBehaviors = false;
 #endif
     ConfigInputTextCursorBlink = true;
+    ConfigInputTextUndoMemoryBudget = 256 * 1024;
+    ConfigInputTextUndoCompress = true;
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigWindowsMemoryCompactTimer = 60.0f;
@@ -1480,17 +1516,33 @@ ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
 
 // Default file functions
 #ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
+#if defined(_WIN32) && !defined(_WINDOWS_) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(__CYGWIN__)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef __MINGW32__
+#include <Windows.h>    // MoveFileExW, MoveFileExA
+#else
+#include <windows.h>
+#endif
+#endif
+
+// The file functions may be called from the background .ini save task (see ImGuiIO::IniSaveAsync),
+// so the UTF-8 -> wchar_t conversion buffers below are allocated with malloc() rather than with IM_ALLOC() and the context.
 ImFileHandle ImFileOpen(const char* filename, const char* mode)
 {
 #if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(__CYGWIN__) && !defined(__GNUC__)
     // We need a fopen() wrapper because MSVC/Windows fopen doesn't handle UTF-8 filenames.
     const int filename_wsize = ImTextCountCharsFromUtf8(filename, NULL) + 1;
     const int mode_wsize = ImTextCountCharsFromUtf8(mode, NULL) + 1;
-    ImVector<ImWchar> buf;
-    buf.resize(filename_wsize + mode_wsize);
+    ImWchar* buf = (ImWchar*)malloc((size_t)(filename_wsize + mode_wsize) * sizeof(ImWchar));
+    if (buf == NULL)
+        return NULL;
     ImTextStrFromUtf8(&buf[0], filename_wsize, filename, NULL);
     ImTextStrFromUtf8(&buf[filename_wsize], mode_wsize, mode, NULL);
-    return _wfopen((wchar_t*)&buf[0], (wchar_t*)&buf[filename_wsize]);
+    ImFileHandle f = _wfopen((wchar_t*)&buf[0], (wchar_t*)&buf[filename_wsize]);
+    free(buf);
+    return f;
 #else
     return fopen(filename, mode);
 #endif
@@ -1501,6 +1553,30 @@ bool    ImFileClose(ImFileHandle f)     { return fclose(f) == 0; }
 ImU64   ImFileGetSize(ImFileHandle f)   { long off = 0, sz = 0; return ((off = ftell(f)) != -1 && !fseek(f, 0, SEEK_END) && (sz = ftell(f)) != -1 && !fseek(f, off, SEEK_SET)) ? (ImU64)sz : (ImU64)-1; }
 ImU64   ImFileRead(void* data, ImU64 sz, ImU64 count, ImFileHandle f)           { return fread(data, (size_t)sz, (size_t)count, f); }
 ImU64   ImFileWrite(const void* data, ImU64 sz, ImU64 count, ImFileHandle f)    { return fwrite(data, (size_t)sz, (size_t)count, f); }
+
+bool ImFileRename(const char* old_filename, const char* new_filename)
+{
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(__CYGWIN__) && !defined(__GNUC__)
+    // Same as ImFileOpen() for UTF-8 filenames. Windows rename() fails when the destination exists, MoveFileEx() replaces it atomically.
+    const int old_filename_wsize = ImTextCountCharsFromUtf8(old_filename, NULL) + 1;
+    const int new_filename_wsize = ImTextCountCharsFromUtf8(new_filename, NULL) + 1;
+    ImWchar* buf = (ImWchar*)malloc((size_t)(old_filename_wsize + new_filename_wsize) * sizeof(ImWchar));
+    if (buf == NULL)
+        return false;
+    ImTextStrFromUtf8(&buf[0], old_filename_wsize, old_filename, NULL);
+    ImTextStrFromUtf8(&buf[old_filename_wsize], new_filename_wsize, new_filename, NULL);
+    const bool ret = ::MoveFileExW((wchar_t*)&buf[0], (wchar_t*)&buf[old_filename_wsize], MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    free(buf);
+    return ret;
+#elif defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && !defined(__CYGWIN__)
+    return ::MoveFileExA(old_filename, new_filename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+#if defined(_WIN32)
+    remove(new_filename); // Not atomic: without the Win32 functions there is no way to replace an existing file
+#endif
+    return rename(old_filename, new_filename) == 0;
+#endif
+}
 #endif // #ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
 
 // Helper: Load file content into memory
@@ -1880,6 +1956,7 @@ void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
     ImGuiStoragePair* it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
         it = Data.insert(it, ImGuiStoragePair(key, default_val));
@@ -1893,6 +1970,7 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
     ImGuiStoragePair* it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
         it = Data.insert(it, ImGuiStoragePair(key, default_val));
@@ -1901,6 +1979,7 @@ float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
     ImGuiStoragePair* it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
         it = Data.insert(it, ImGuiStoragePair(key, default_val));
@@ -1910,6 +1989,7 @@ void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 // FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
     ImGuiStoragePair* it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
     {
@@ -1926,6 +2006,7 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
     ImGuiStoragePair* it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
     {
@@ -1937,6 +2018,7 @@ void ImGuiStorage::SetFloat(ImGuiID key, float val)
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
     ImGuiStoragePair* it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
     {
@@ -1959,6 +2041,10 @@ void ImGuiStorage::SetAllInt(int v)
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
 {
+    MatchClassesCount = MatchStartClassesCount = 0;
+    MatchFirstTerm = -1;
+    LinesFiltered = 0;
+    LinesSource = NULL;
     if (default_filter)
     {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
@@ -2018,6 +2104,92 @@ void ImGuiTextFilter::Build()
         if (Filters[i].b[0] != '-')
             CountGrep += 1;
     }
+
+    // Compile the terms into an Aho-Corasick automaton over case-folded bytes (same folding as ImStristr).
+    // Bytes are first mapped to a small number of classes, so the transition table stays small: at most 256 states (the size of InputBuf) by the number of distinct characters.
+    // The first characters of the terms get the first classes, so PassFilter() can skip other characters with a single comparison.
+    memset(MatchClass, 0, sizeof(MatchClass));
+    MatchClassesCount = 1;
+    MatchFirstTerm = -1;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i != Filters.Size; i++)
+        {
+            const char* term = Filters[i].b + (Filters[i].b < Filters[i].e && Filters[i].b[0] == '-' ? 1 : 0);
+            for (const char* p = term; p < Filters[i].e && (pass == 1 || p == term); p++)
+            {
+                const int c = toupper((unsigned char)*p);
+                if (MatchClass[c] == 0)
+                    MatchClass[c] = MatchClass[tolower(c)] = (unsigned char)MatchClassesCount++;
+            }
+        }
+        if (pass == 0)
+            MatchStartClassesCount = MatchClassesCount;
+    }
+
+    // Build the trie, where 0 (the root) stands for no transition
+    const int classes_count = MatchClassesCount;
+    MatchNext.resize(classes_count);
+    memset(MatchNext.Data, 0, (size_t)MatchNext.size_in_bytes());
+    MatchTerm.resize(1);
+    MatchTerm[0] = -1;
+    for (int i = 0; i != Filters.Size; i++)
+    {
+        const char* term = Filters[i].b + (Filters[i].b < Filters[i].e && Filters[i].b[0] == '-' ? 1 : 0);
+        if (term >= Filters[i].e)
+            continue; // Empty terms never match, same as ImStristr()
+        int state = 0;
+        for (const char* p = term; p < Filters[i].e; p++)
+        {
+            const int cls = MatchClass[(unsigned char)*p];
+            if (MatchNext[state * classes_count + cls] == 0)
+            {
+                MatchNext[state * classes_count + cls] = (ImU16)MatchTerm.Size;
+                MatchNext.resize(MatchNext.Size + classes_count, 0);
+                MatchTerm.push_back(-1);
+            }
+            state = MatchNext[state * classes_count + cls];
+        }
+        if (MatchTerm[state] == -1)
+            MatchTerm[state] = (short)i;
+        if (MatchFirstTerm == -1)
+            MatchFirstTerm = i;
+    }
+
+    // Turn the trie into a complete automaton, visiting states in breadth-first order so the state of the longest proper suffix is always complete.
+    // Each state also inherits the terms ending at its suffix state.
+    const int states_count = MatchTerm.Size;
+    ImVector<int> queue;
+    ImVector<int> suffix;
+    queue.reserve(states_count);
+    suffix.resize(states_count, 0);
+    for (int cls = 1; cls < classes_count; cls++)
+        if (MatchNext[cls] != 0)
+            queue.push_back(MatchNext[cls]);
+    for (int queue_n = 0; queue_n < queue.Size; queue_n++)
+    {
+        const int state = queue[queue_n];
+        const int state_suffix = suffix[state];
+        if (MatchTerm[state_suffix] != -1 && (MatchTerm[state] == -1 || MatchTerm[state_suffix] < MatchTerm[state]))
+            MatchTerm[state] = MatchTerm[state_suffix];
+        for (int cls = 1; cls < classes_count; cls++)
+        {
+            const int child = MatchNext[state * classes_count + cls];
+            const int suffix_next = MatchNext[state_suffix * classes_count + cls];
+            if (child != 0)
+            {
+                suffix[child] = suffix_next;
+                queue.push_back(child);
+            }
+            else
+            {
+                MatchNext[state * classes_count + cls] = (ImU16)suffix_next;
+            }
+        }
+    }
+
+    LinesPassed.resize(0);
+    LinesFiltered = 0;
 }
 
 bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
@@ -2027,26 +2199,46 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
     if (text == NULL)
         text = "";
-
-    for (int i = 0; i != Filters.Size; i++)
-    {
-        const ImGuiTextRange& f = Filters[i];
-        if (f.empty())
-            continue;
-        if (f.b[0] == '-')
-        {
-            // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
-                return false;
-        }
-        else
-        {
-            // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
-                return true;
+    if (text_end == NULL)
+        text_end = text + strlen(text);
+
+    // Find the first term in Filters[] order matching anywhere in the text. It decides the result, same as testing the terms one after the other.
+    const int classes_count = MatchClassesCount;
+    const unsigned char* match_class = MatchClass;
+    const ImU16* match_next = MatchNext.Data;
+    const short* match_term = MatchTerm.Data;
+    const unsigned int start_classes_count = (unsigned int)MatchStartClassesCount - 1;
+    int first_term = INT_MAX;
+    if (MatchFirstTerm != -1)
+    {
+        int state = 0;
+        const unsigned char* p_end = (const unsigned char*)text_end;
+        for (const unsigned char* p = (const unsigned char*)text; p < p_end; p++)
+        {
+            // Fast-forward over characters which don't start any term (their class is 0 or above the start classes, so class - 1 wraps or is too large)
+            if (state == 0)
+            {
+                while (p + 4 <= p_end && match_class[p[0]] - 1u >= start_classes_count && match_class[p[1]] - 1u >= start_classes_count && match_class[p[2]] - 1u >= start_classes_count && match_class[p[3]] - 1u >= start_classes_count)
+                    p += 4;
+                while (p < p_end && match_class[*p] - 1u >= start_classes_count)
+                    p++;
+                if (p == p_end)
+                    break;
+            }
+            state = match_next[state * classes_count + match_class[*p]];
+            const int term = match_term[state];
+            if (term != -1 && term < first_term)
+            {
+                first_term = term;
+                if (first_term == MatchFirstTerm)
+                    break;
+            }
         }
     }
 
+    if (first_term != INT_MAX)
+        return Filters[first_term].b[0] != '-'; // Subtract or Grep
+
     // Implicit * grep
     if (CountGrep == 0)
         return true;
@@ -2054,6 +2246,47 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+// Lines added since the last call are filtered, the previous last line is filtered again in case it got appended to.
+// Calling Build() (e.g. when the filter is edited), passing less lines than before or another buffer filters all lines again.
+// Lines replaced in place can't be detected: callers need to call Build() (e.g. ImGuiTextLog::Clear() does).
+const ImVector<int>& ImGuiTextFilter::PassFilterLines(const char* buf, const char* buf_end, const int* line_offsets, int lines_count)
+{
+    if (LinesFiltered > lines_count || LinesSource != buf)
+        LinesFiltered = 0;
+    LinesSource = buf;
+    if (LinesFiltered > 0)
+        LinesFiltered--;
+    while (LinesPassed.Size > 0 && LinesPassed.back() >= LinesFiltered)
+        LinesPassed.pop_back();
+
+    for (int line_no = LinesFiltered; line_no < lines_count; line_no++)
+    {
+        const char* line_start = buf + line_offsets[line_no];
+        const char* line_end = (line_no + 1 < lines_count) ? (buf + line_offsets[line_no + 1] - 1) : buf_end;
+        if (PassFilter(line_start, line_end))
+            LinesPassed.push_back(line_no);
+    }
+    LinesFiltered = lines_count;
+    return LinesPassed;
+}
+
+const ImVector<int>& ImGuiTextFilter::PassFilterLines(const char* const* lines, int lines_count)
+{
+    if (LinesFiltered > lines_count || LinesSource != lines)
+        LinesFiltered = 0;
+    LinesSource = lines;
+    if (LinesFiltered > 0)
+        LinesFiltered--;
+    while (LinesPassed.Size > 0 && LinesPassed.back() >= LinesFiltered)
+        LinesPassed.pop_back();
+
+    for (int line_no = LinesFiltered; line_no < lines_count; line_no++)
+        if (PassFilter(lines[line_no]))
+            LinesPassed.push_back(line_no);
+    LinesFiltered = lines_count;
+    return LinesPassed;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -2123,6 +2356,81 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
     va_end(args_copy);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiTextLog
+//-----------------------------------------------------------------------------
+
+ImGuiTextLog::ImGuiTextLog()
+{
+    AutoScroll = true;
+    Clear();
+}
+
+void ImGuiTextLog::Clear()
+{
+    Buf.clear();
+    LineOffsets.clear();
+    LineOffsets.push_back(0);
+    Filter.Build(); // Filter all lines again
+}
+
+// Record the start of the lines appended to Buf since 'old_size'
+static void TextLogAddLineOffsets(ImGuiTextLog* log, int old_size)
+{
+    const char* buf = log->Buf.begin();
+    const char* buf_end = log->Buf.end();
+    for (const char* p = buf + old_size; p < buf_end; p++)
+    {
+        p = (const char*)memchr(p, '\n', (size_t)(buf_end - p));
+        if (p == NULL)
+            break;
+        log->LineOffsets.push_back((int)(p - buf) + 1);
+    }
+}
+
+void ImGuiTextLog::Append(const char* text, const char* text_end)
+{
+    const int old_size = Buf.size();
+    Buf.append(text, text_end);
+    TextLogAddLineOffsets(this, old_size);
+}
+
+void ImGuiTextLog::AppendF(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    AppendFV(fmt, args);
+    va_end(args);
+}
+
+void ImGuiTextLog::AppendFV(const char* fmt, va_list args)
+{
+    const int old_size = Buf.size();
+    Buf.appendfv(fmt, args);
+    TextLogAddLineOffsets(this, old_size);
+}
+
+void ImGuiTextLog::Draw(const char* str_id, const ImVec2& size)
+{
+    ImGui::BeginChild(str_id, size, false, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
+
+    // When the filter is active, display the indices of the lines passing it
+    const ImVector<int>* lines = Filter.IsActive() ? &Filter.PassFilterLines(Buf.begin(), Buf.end(), LineOffsets.Data, LineOffsets.Size) : NULL;
+    ImGuiListClipper clipper(lines ? lines->Size : LineOffsets.Size);
+    while (clipper.Step())
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+        {
+            const int line_no = lines ? (*lines)[n] : n;
+            ImGui::TextUnformatted(GetLineBegin(line_no), GetLineEnd(line_no));
+        }
+
+    ImGui::PopStyleVar();
+    if (AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+        ImGui::SetScrollHereY(1.0f);
+    ImGui::EndChild();
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 // This is currently not as flexible/powerful as it should be and really confusing/spaghetti, mostly because we changed
@@ -2258,6 +2566,250 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+void ImGuiListClipperState::ClearHeights()
+{
+    if (Heights.Size == 0)
+        return;
+    memset(Heights.Data, 0, (size_t)Heights.size_in_bytes());
+    memset(TreeHeights.Data, 0, (size_t)TreeHeights.size_in_bytes());
+    memset(TreeKnown.Data, 0, (size_t)TreeKnown.size_in_bytes());
+    KnownHeight = 0.0f;
+    KnownCount = 0;
+}
+
+void ImGuiListClipperState::Resize(int items_count)
+{
+    const int old_count = Heights.Size;
+    if (items_count == old_count)
+        return;
+    if (items_count < old_count)
+    {
+        // Fenwick nodes only cover items before them, so truncating keeps the remaining nodes valid
+        for (int n = items_count; n < old_count; n++)
+            if (Heights[n] > 0.0f)
+            {
+                KnownHeight -= Heights[n];
+                KnownCount--;
+            }
+        Heights.shrink(items_count);
+        TreeHeights.shrink(items_count);
+        TreeKnown.shrink(items_count);
+        if (KnownCount == 0)
+            KnownHeight = 0.0f;
+        return;
+    }
+
+    Heights.resize(items_count, 0.0f);
+    TreeHeights.resize(items_count, 0.0f);
+    TreeKnown.resize(items_count, 0);
+    if (items_count - old_count > old_count)
+    {
+        // Rebuild in linear time when most items are new (e.g. first use)
+        for (int n = 0; n < items_count; n++)
+        {
+            TreeHeights[n] = Heights[n];
+            TreeKnown[n] = (Heights[n] > 0.0f) ? 1 : 0;
+        }
+        for (int i = 1; i <= items_count; i++)
+        {
+            int parent = i + (i & -i);
+            if (parent <= items_count)
+            {
+                TreeHeights[parent - 1] += TreeHeights[i - 1];
+                TreeKnown[parent - 1] += TreeKnown[i - 1];
+            }
+        }
+        return;
+    }
+
+    // New items are unknown: each new node only has to sum the old items it covers, from the nodes already in place
+    for (int i = old_count + 1; i <= items_count; i++)
+    {
+        float h = 0.0f;
+        int known = 0;
+        for (int j = i - 1, j_min = i - (i & -i); j > j_min; j -= (j & -j))
+        {
+            h += TreeHeights[j - 1];
+            known += TreeKnown[j - 1];
+        }
+        TreeHeights[i - 1] = h;
+        TreeKnown[i - 1] = known;
+    }
+}
+
+void ImGuiListClipperState::SetHeight(int idx, float height)
+{
+    IM_ASSERT(idx >= 0 && idx < Heights.Size);
+    if (height < 0.0f)
+        height = 0.0f;
+    const float old_height = Heights[idx];
+    if (old_height == height)
+        return;
+    const float d_height = height - old_height;
+    const int d_known = (height > 0.0f ? 1 : 0) - (old_height > 0.0f ? 1 : 0);
+    Heights[idx] = height;
+    KnownHeight += d_height;
+    KnownCount += d_known;
+    for (int i = idx + 1; i <= Heights.Size; i += (i & -i))
+    {
+        TreeHeights[i - 1] += d_height;
+        TreeKnown[i - 1] += d_known;
+    }
+}
+
+float ImGuiListClipperState::GetOffset(int idx) const
+{
+    IM_ASSERT(idx >= 0 && idx <= Heights.Size);
+    float h = 0.0f;
+    int known = 0;
+    for (int i = idx; i > 0; i -= (i & -i))
+    {
+        h += TreeHeights[i - 1];
+        known += TreeKnown[i - 1];
+    }
+    return h + (idx - known) * GetEstimatedHeight();
+}
+
+int ImGuiListClipperState::FindIndex(float offset) const
+{
+    // Descend the trees to find the number of items ending before 'offset'
+    const int count = Heights.Size;
+    const float est_height = GetEstimatedHeight();
+    int pos = 0;
+    float h = 0.0f;
+    int known = 0;
+    int step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+    for (; step > 0; step >>= 1)
+    {
+        const int next = pos + step;
+        if (next > count)
+            continue;
+        const float next_h = h + TreeHeights[next - 1];
+        const int next_known = known + TreeKnown[next - 1];
+        if (next_h + (next - next_known) * est_height > offset)
+            continue;
+        pos = next;
+        h = next_h;
+        known = next_known;
+    }
+    return ImClamp(pos, 0, ImMax(count - 1, 0));
+}
+
+ImGuiListClipperVariable::ImGuiListClipperVariable(const char* str_id, int items_count, float items_height)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    const ImGuiID id = window->GetID(str_id);
+    ImGuiListClipperState* state = g.ListClippers.GetOrAddByKey(id);
+    state->ID = id;
+    state->DefaultHeight = (items_height > 0.0f) ? items_height : ImGui::GetTextLineHeightWithSpacing();
+    StateIdx = g.ListClippers.GetIndex(state);
+    ItemsCount = items_count;
+    DisplayStart = DisplayEnd = -1;
+    StepNo = 0;
+    StartPosY = ItemPosY = ClipMaxY = 0.0f;
+    AnchorIdx = -1;
+    AnchorOffset = 0.0f;
+}
+
+bool ImGuiListClipperVariable::Step()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (ItemsCount < 0)
+        return false;
+    ImGuiListClipperState* state = g.ListClippers.GetByIndex(StateIdx);
+
+    if (StepNo == 0) // Step 0: find the first visible item from the cached heights, and position the cursor before it.
+    {
+        if (ItemsCount == 0 || window->SkipItems)
+        {
+            ItemsCount = -1;
+            return false;
+        }
+        state->LastFrameActive = g.FrameCount;
+        state->Resize(ItemsCount);
+        const float width = ImGui::GetContentRegionAvail().x;
+        if (state->Width != width)
+        {
+            state->ClearHeights();
+            state->Width = width;
+        }
+
+        StartPosY = window->DC.CursorPos.y;
+        int start = 0;
+        if (g.LogEnabled)
+        {
+            // If logging is active, do not perform any clipping
+            ClipMaxY = FLT_MAX;
+        }
+        else
+        {
+            // Same as CalcListClipping(): union of the ClipRect and the NavScoringRect, with one item extra in the direction we are moving to
+            ImRect unclipped_rect = window->ClipRect;
+            if (g.NavMoveRequest)
+                unclipped_rect.Add(g.NavScoringRectScreen);
+            start = state->FindIndex(unclipped_rect.Min.y - StartPosY);
+            if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Up)
+                start = ImMax(start - 1, 0);
+            ClipMaxY = unclipped_rect.Max.y;
+            if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Down)
+                ClipMaxY += state->GetEstimatedHeight();
+        }
+
+        // Remember where the first visible item is, so End() can keep it in place if heights above it change
+        AnchorIdx = state->FindIndex(window->ClipRect.Min.y - StartPosY);
+        AnchorOffset = state->GetOffset(AnchorIdx);
+
+        if (start > 0)
+            SetCursorPosYAndSetupDummyPrevLine(StartPosY + state->GetOffset(start), state->GetEstimatedHeight());
+        DisplayStart = start;
+        DisplayEnd = start + 1;
+        ItemPosY = window->DC.CursorPos.y;
+        StepNo = 1;
+        return true;
+    }
+    if (StepNo == 1) // Step 1: measure the item we just displayed, and carry on with the next one until we reach the bottom of the visible area.
+    {
+        state->SetHeight(DisplayStart, window->DC.CursorPos.y - ItemPosY);
+        if (DisplayEnd >= ItemsCount || window->DC.CursorPos.y >= ClipMaxY)
+        {
+            End();
+            return false;
+        }
+        DisplayStart = DisplayEnd;
+        DisplayEnd++;
+        ItemPosY = window->DC.CursorPos.y;
+        return true;
+    }
+    End();
+    return false;
+}
+
+void ImGuiListClipperVariable::End()
+{
+    if (ItemsCount < 0)
+        return;
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiListClipperState* state = g.ListClippers.GetByIndex(StateIdx);
+
+    // Heights measured this frame (or the estimate they changed) moved the first visible item: scroll by the same amount so it stays in place.
+    // This is applied on the next frame, unless the user already requested a scroll or is dragging the scrollbar.
+    if (AnchorIdx > 0)
+    {
+        const float delta = state->GetOffset(AnchorIdx) - AnchorOffset;
+        if (delta != 0.0f && window->ScrollTarget.y == FLT_MAX && g.ActiveId != ImGui::GetWindowScrollbarID(window, ImGuiAxis_Y))
+            ImGui::SetScrollY(window, window->Scroll.y + delta);
+    }
+
+    SetCursorPosYAndSetupDummyPrevLine(StartPosY + state->GetOffset(ItemsCount), state->GetEstimatedHeight());
+    ItemsCount = -1;
+    StepNo = 2;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] RENDER HELPERS
 // Some of those (internal) functions are currently quite a legacy mess - their signature and behavior will change.
@@ -2659,6 +3211,7 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* context, const char* name)
 
     MemoryCompacted = false;
     MemoryDrawListIdxCapacity = MemoryDrawListVtxCapacity = 0;
+    MemoryDrawListIdxHighWater = MemoryDrawListVtxHighWater = 0;
 }
 
 ImGuiWindow::~ImGuiWindow()
@@ -2759,6 +3312,166 @@ void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
     window->MemoryDrawListIdxCapacity = window->MemoryDrawListVtxCapacity = 0;
 }
 
+// Reallocate draw list buffers to smaller capacities (never below their current size, so the contents stay valid and can still be rendered).
+void ImGui::GcShrinkDrawList(ImDrawList* draw_list, int idx_capacity, int vtx_capacity)
+{
+    ImVectorShrink(&draw_list->IdxBuffer, idx_capacity);
+    ImVectorShrink(&draw_list->VtxBuffer, vtx_capacity);
+    ImVectorShrink(&draw_list->CmdBuffer, draw_list->CmdBuffer.Size + draw_list->CmdBuffer.Size / 2);
+    ImVectorShrink(&draw_list->_ClipRectStack, 0);
+    ImVectorShrink(&draw_list->_TextureIdStack, 0);
+    ImVectorShrink(&draw_list->_Path, 0);
+    if (draw_list->_Splitter._Count <= 1)
+        draw_list->_Splitter.ClearFreeMemory();
+}
+
+// Shrink the draw list of a window whose capacity is more than twice the largest size it was used at since the last call.
+// This catches draw lists which spiked once (e.g. a large tree was expanded for a moment) and would otherwise hold onto that memory.
+static void GcShrinkWindowDrawList(ImGuiWindow* window)
+{
+    ImDrawList* draw_list = window->DrawList;
+    const int idx_high_water = ImMax(window->MemoryDrawListIdxHighWater, draw_list->IdxBuffer.Size);
+    const int vtx_high_water = ImMax(window->MemoryDrawListVtxHighWater, draw_list->VtxBuffer.Size);
+    window->MemoryDrawListIdxHighWater = window->MemoryDrawListVtxHighWater = 0;
+    const bool idx_spiked = draw_list->IdxBuffer.Capacity > 4096 && draw_list->IdxBuffer.Capacity > idx_high_water * 2;
+    const bool vtx_spiked = draw_list->VtxBuffer.Capacity > 4096 && draw_list->VtxBuffer.Capacity > vtx_high_water * 2;
+    if (idx_spiked || vtx_spiked)
+        ImGui::GcShrinkDrawList(draw_list, idx_high_water + idx_high_water / 2, vtx_high_water + vtx_high_water / 2);
+}
+
+static void GcCompactColumns(ImGuiWindow* window)
+{
+    for (int n = 0; n < window->ColumnsStorage.Size; n++)
+    {
+        ImGuiColumns* columns = &window->ColumnsStorage[n];
+        ImVectorShrink(&columns->Columns, 0);
+        if (columns->Splitter._Count <= 1)
+            columns->Splitter.ClearFreeMemory();
+    }
+}
+
+void ImGui::CompactMemory(ImGuiCompactLevel level)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(level >= ImGuiCompactLevel_Low && level <= ImGuiCompactLevel_High);
+    if (g.WithinFrameScope)
+        g.MemoryCompactRequest = ImMax(g.MemoryCompactRequest, level); // Buffers are in use, wait for the next NewFrame()
+    else
+        GcCompactMemory(level);
+}
+
+// Release memory on request (see CompactMemory() and ImGuiCompactLevel_ for what each level does).
+// At this point we are outside of a frame, 'window->Active' and 'tab_bar->CurrFrameVisible' refer to the last frame.
+void ImGui::GcCompactMemory(ImGuiCompactLevel level)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(!g.WithinFrameScope);
+
+    // Windows
+    for (int i = 0; i != g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!window->Active || level >= ImGuiCompactLevel_High)
+        {
+            if (!window->MemoryCompacted)
+                GcCompactTransientWindowBuffers(window);
+            if (level >= ImGuiCompactLevel_High)
+                window->MemoryDrawListIdxCapacity = window->MemoryDrawListVtxCapacity = 0; // Don't reserve it all back when the window is awakened
+            GcCompactColumns(window);
+        }
+        else if (level >= ImGuiCompactLevel_Medium)
+        {
+            GcShrinkDrawList(window->DrawList, 0, 0);
+            GcCompactColumns(window);
+        }
+        else
+        {
+            GcShrinkWindowDrawList(window);
+        }
+    }
+
+    // Tab bars
+    for (int n = 0; n < g.TabBars.GetSize(); n++)
+    {
+        ImGuiTabBar* tab_bar = g.TabBars.GetByIndex(n);
+        if (tab_bar->CurrFrameVisible < g.FrameCount || level >= ImGuiCompactLevel_Medium)
+        {
+            ImVectorShrink(&tab_bar->Tabs, 0);
+            ImVectorShrink(&tab_bar->TabsNames.Buf, 0);
+            tab_bar->TabsIndex.Clear();     // Rebuilt on the next lookup
+            tab_bar->TabsIndexDirty = true;
+        }
+    }
+
+    // Plots: decimated data is computed again on their next use
+    for (int n = 0; n < g.Plots.GetSize(); n++)
+    {
+        ImGuiPlotState* plot = g.Plots.GetByIndex(n);
+        if (plot->LastFrameActive < g.FrameCount || level >= ImGuiCompactLevel_Medium)
+        {
+            plot->Points.clear();
+            plot->ValuesCount = -1;
+        }
+    }
+
+    // Clippers: heights are measured again and rows are rebuilt on their next use
+    for (int n = 0; n < g.ListClippers.GetSize(); n++)
+    {
+        ImGuiListClipperState* clipper = g.ListClippers.GetByIndex(n);
+        if (clipper->LastFrameActive < g.FrameCount || level >= ImGuiCompactLevel_Medium)
+        {
+            clipper->Heights.clear();
+            clipper->TreeHeights.clear();
+            clipper->TreeKnown.clear();
+            clipper->KnownHeight = 0.0f;
+            clipper->KnownCount = 0;
+        }
+    }
+    for (int n = 0; n < g.TreeClippers.GetSize(); n++)
+    {
+        ImGuiTreeClipperState* clipper = g.TreeClippers.GetByIndex(n);
+        if (clipper->LastFrameActive < g.FrameCount || level >= ImGuiCompactLevel_Medium)
+        {
+            clipper->Rows.clear();
+            clipper->NodesCount = -1;
+        }
+    }
+    if (level < ImGuiCompactLevel_Medium)
+        return;
+
+    // Context buffers
+    GcShrinkDrawList(&g.BackgroundDrawList, 0, 0);
+    GcShrinkDrawList(&g.ForegroundDrawList, 0, 0);
+    g.WindowsTempSortBuffer.clear();
+    g.ShrinkWidthBuffer.clear();
+    g.FrameArena.clear();
+
+    // InputText state is kept while its widget is active, otherwise it is rebuilt on activation
+    ImGuiInputTextState* state = &g.InputTextState;
+    if (state->ID != 0 && state->ID != g.ActiveId)
+    {
+        state->ClearFreeMemory();
+        state->ID = 0;
+    }
+
+    // RGBA32 pixels are converted from the Alpha8 ones on demand, they are not needed anymore once the renderer has created its texture
+    ImFontAtlas* atlas = g.IO.Fonts;
+    if (atlas->TexPixelsRGBA32 != NULL && atlas->TexPixelsAlpha8 != NULL && atlas->TexID != (ImTextureID)NULL && !atlas->Locked)
+    {
+        IM_FREE(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = NULL;
+    }
+    if (level < ImGuiCompactLevel_High)
+        return;
+
+    // Drop everything the next frame can rebuild (this invalidates the last frame ImDrawData)
+    g.BackgroundDrawList.ClearFreeMemory();
+    g.ForegroundDrawList.ClearFreeMemory();
+    g.DrawDataBuilder.ClearFreeMemory();
+    if (state->ID != 0)
+        state->UndoClear();
+}
+
 void ImGui::SetActiveID(ImGuiID id, ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
@@ -3052,65 +3765,192 @@ bool ImGui::FocusableItemRegister(ImGuiWindow* window, ImGuiID id)
     // (Note that we can always TAB out of a widget that doesn't allow tabbing in)
     if (g.ActiveId == id && g.FocusTabPressed && !IsActiveIdUsingKey(ImGuiKey_Tab) && g.FocusRequestNextWindow == NULL)
     {
-        g.FocusRequestNextWindow = window;
-        g.FocusRequestNextCounterTabStop = window->DC.FocusCounterTabStop + (g.IO.KeyShift ? (is_tab_stop ? -1 : 0) : +1); // Modulo on index will be applied at the end of frame once we've got the total counter of items.
+        g.FocusRequestNextWindow = window;
+        g.FocusRequestNextCounterTabStop = window->DC.FocusCounterTabStop + (g.IO.KeyShift ? (is_tab_stop ? -1 : 0) : +1); // Modulo on index will be applied at the end of frame once we've got the total counter of items.
+    }
+
+    // Handle focus requests
+    if (g.FocusRequestCurrWindow == window)
+    {
+        if (window->DC.FocusCounterRegular == g.FocusRequestCurrCounterRegular)
+            return true;
+        if (is_tab_stop && window->DC.FocusCounterTabStop == g.FocusRequestCurrCounterTabStop)
+        {
+            g.NavJustTabbedId = id;
+            return true;
+        }
+
+        // If another item is about to be focused, we clear our own active id
+        if (g.ActiveId == id)
+            ClearActiveID();
+    }
+
+    return false;
+}
+
+void ImGui::FocusableItemUnregister(ImGuiWindow* window)
+{
+    window->DC.FocusCounterRegular--;
+    window->DC.FocusCounterTabStop--;
+}
+
+float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
+{
+    if (wrap_pos_x < 0.0f)
+        return 0.0f;
+
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    if (wrap_pos_x == 0.0f)
+        wrap_pos_x = window->WorkRect.Max.x;
+    else if (wrap_pos_x > 0.0f)
+        wrap_pos_x += window->Pos.x - window->Scroll.x; // wrap_pos_x is provided is window local space
+
+    return ImMax(wrap_pos_x - pos.x, 1.0f);
+}
+
+// IM_ALLOC() == ImGui::MemAlloc()
+void* ImGui::MemAlloc(size_t size)
+{
+    if (ImGuiContext* ctx = GImGui)
+        ImAtomicAdd(&ctx->IO.MetricsActiveAllocations, 1);
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    IM_STATIC_ASSERT(sizeof(ImGuiMemAllocHeader) <= IM_MEM_ALLOC_HEADER_SIZE);
+    char* ptr = (char*)GImAllocatorAllocFunc(size + IM_MEM_ALLOC_HEADER_SIZE, GImAllocatorUserData);
+    if (ptr == NULL)
+        return NULL;
+    ImGuiMemAllocHeader* header = (ImGuiMemAllocHeader*)(void*)ptr;
+    header->Size = size;
+    header->Tag = GImMemTagCurrent;
+    ImGuiMemTagStats* stats = &GImMemTagStats[header->Tag];
+    const size_t bytes = ImAtomicAdd(&stats->Bytes, size);
+    for (size_t peak_bytes = ImAtomicAdd(&stats->PeakBytes, 0); bytes > peak_bytes; )
+    {
+        const size_t prev_peak_bytes = ImAtomicCompareExchange(&stats->PeakBytes, peak_bytes, bytes);
+        if (prev_peak_bytes == peak_bytes)
+            break;
+        peak_bytes = prev_peak_bytes;
+    }
+    ImAtomicAdd(&stats->Allocs, 1);
+    ImAtomicAdd(&stats->TotalAllocs, 1);
+    ImAtomicAdd(&stats->CurrFrameAllocs, 1);
+    return ptr + IM_MEM_ALLOC_HEADER_SIZE;
+#else
+    return GImAllocatorAllocFunc(size, GImAllocatorUserData);
+#endif
+}
+
+// IM_FREE() == ImGui::MemFree()
+void ImGui::MemFree(void* ptr)
+{
+    if (ptr)
+        if (ImGuiContext* ctx = GImGui)
+            ImAtomicAdd(&ctx->IO.MetricsActiveAllocations, -1);
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    if (ptr)
+    {
+        ptr = (char*)ptr - IM_MEM_ALLOC_HEADER_SIZE;
+        const ImGuiMemAllocHeader* header = (const ImGuiMemAllocHeader*)ptr;
+        ImGuiMemTagStats* stats = &GImMemTagStats[header->Tag];
+        ImAtomicAdd(&stats->Bytes, (size_t)0 - header->Size);
+        ImAtomicAdd(&stats->Allocs, -1);
+    }
+#endif
+    return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
+}
+
+const ImGuiMemTagStats* ImGui::GetMemTagStats(ImGuiMemTag tag)
+{
+    IM_ASSERT(tag >= 0 && tag < ImGuiMemTag_COUNT);
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    return &GImMemTagStats[tag];
+#else
+    IM_UNUSED(tag);
+    return NULL;
+#endif
+}
+
+const char* ImGui::GetMemTagName(ImGuiMemTag tag)
+{
+    const char* names[] = { "Other", "DrawList", "Window", "Storage", "Font", "InputText", "Settings", "Columns", "TabBar" };
+    IM_ASSERT(IM_ARRAYSIZE(names) == ImGuiMemTag_COUNT && tag >= 0 && tag < ImGuiMemTag_COUNT);
+    return names[tag];
+}
+
+void* ImGui::MemAllocFrame(size_t size)
+{
+#ifndef IMGUI_DISABLE_FRAME_ARENA
+    ImGuiContext& g = *GImGui;
+    return g.FrameArena.alloc(size);
+#else
+    return MemAlloc(size);
+#endif
+}
+
+void ImGui::MemFreeFrame(void* ptr)
+{
+#ifndef IMGUI_DISABLE_FRAME_ARENA
+    IM_UNUSED(ptr);
+#else
+    MemFree(ptr);
+#endif
+}
+
+void* ImLinearArena::alloc(size_t sz)
+{
+    AllocCount++;
+    if (sz > (size_t)(BlockSize & ~15))
+    {
+        // Don't keep a block of that size around for the rest of the session
+        void* p = IM_ALLOC(sz);
+        LargeAllocs.push_back(p);
+        return p;
     }
-
-    // Handle focus requests
-    if (g.FocusRequestCurrWindow == window)
+    sz = (sz + 15) & ~(size_t)15;
+    while (CurrBlock < Blocks.Size && BlocksSize[CurrBlock] - CurrOffset < (int)sz)
     {
-        if (window->DC.FocusCounterRegular == g.FocusRequestCurrCounterRegular)
-            return true;
-        if (is_tab_stop && window->DC.FocusCounterTabStop == g.FocusRequestCurrCounterTabStop)
-        {
-            g.NavJustTabbedId = id;
-            return true;
-        }
-
-        // If another item is about to be focused, we clear our own active id
-        if (g.ActiveId == id)
-            ClearActiveID();
+        CurrBlock++;
+        CurrOffset = 0;
     }
-
-    return false;
+    if (CurrBlock == Blocks.Size)
+    {
+        Blocks.push_back((char*)IM_ALLOC((size_t)BlockSize));
+        BlocksSize.push_back(BlockSize);
+    }
+    char* p = Blocks[CurrBlock] + CurrOffset;
+    CurrOffset += (int)sz;
+    return p;
 }
 
-void ImGui::FocusableItemUnregister(ImGuiWindow* window)
+void ImLinearArena::reset()
 {
-    window->DC.FocusCounterRegular--;
-    window->DC.FocusCounterTabStop--;
+    for (int n = 0; n < LargeAllocs.Size; n++)
+        IM_FREE(LargeAllocs[n]);
+    LargeAllocs.resize(0);
+    CurrBlock = CurrOffset = AllocCount = 0;
 }
 
-float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
+void ImLinearArena::clear()
 {
-    if (wrap_pos_x < 0.0f)
-        return 0.0f;
-
-    ImGuiWindow* window = GImGui->CurrentWindow;
-    if (wrap_pos_x == 0.0f)
-        wrap_pos_x = window->WorkRect.Max.x;
-    else if (wrap_pos_x > 0.0f)
-        wrap_pos_x += window->Pos.x - window->Scroll.x; // wrap_pos_x is provided is window local space
-
-    return ImMax(wrap_pos_x - pos.x, 1.0f);
+    reset();
+    for (int n = 0; n < Blocks.Size; n++)
+        IM_FREE(Blocks[n]);
+    Blocks.clear();
+    BlocksSize.clear();
+    LargeAllocs.clear();
 }
 
-// IM_ALLOC() == ImGui::MemAlloc()
-void* ImGui::MemAlloc(size_t size)
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+ImGuiMemTagScope::ImGuiMemTagScope(ImGuiMemTag tag)
 {
-    if (ImGuiContext* ctx = GImGui)
-        ctx->IO.MetricsActiveAllocations++;
-    return GImAllocatorAllocFunc(size, GImAllocatorUserData);
+    BackupTag = GImMemTagCurrent;
+    GImMemTagCurrent = tag;
 }
 
-// IM_FREE() == ImGui::MemFree()
-void ImGui::MemFree(void* ptr)
+ImGuiMemTagScope::~ImGuiMemTagScope()
 {
-    if (ptr)
-        if (ImGuiContext* ctx = GImGui)
-            ctx->IO.MetricsActiveAllocations--;
-    return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
+    GImMemTagCurrent = BackupTag;
 }
+#endif
 
 const char* ImGui::GetClipboardText()
 {
@@ -3607,17 +4447,39 @@ void ImGui::NewFrame()
         g.SettingsDirtyTimer -= g.IO.DeltaTime;
         if (g.SettingsDirtyTimer <= 0.0f)
         {
-            if (g.IO.IniFilename != NULL)
-                SaveIniSettingsToDisk(g.IO.IniFilename);
-            else
-                g.IO.WantSaveIniSettings = true;  // Let user know they can call SaveIniSettingsToMemory(). user will need to clear io.WantSaveIniSettings themselves.
             g.SettingsDirtyTimer = 0.0f;
+            if (g.IO.IniFilename == NULL)
+                g.IO.WantSaveIniSettings = true;  // Let user know they can call SaveIniSettingsToMemory(). user will need to clear io.WantSaveIniSettings themselves.
+            else if (g.IO.IniSaveAsync == NULL)
+                SaveIniSettingsToDisk(g.IO.IniFilename);
+            else if (!SaveIniSettingsToDiskAsync(g.IO.IniFilename))
+                g.SettingsDirtyTimer = FLT_MIN;   // Previous save still in flight: try again next frame, which also picks up changes made meanwhile
         }
     }
+    UpdateSettingsSaveTask(&g, false);
+
+    // Apply CompactMemory() requests made during the last frame, now that its draw data isn't used anymore
+    if (g.MemoryCompactRequest >= 0)
+    {
+        GcCompactMemory(g.MemoryCompactRequest);
+        g.MemoryCompactRequest = -1;
+    }
 
     g.Time += g.IO.DeltaTime;
     g.WithinFrameScope = true;
     g.FrameCount += 1;
+    g.FrameArena.reset();
+
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    // Roll per-frame allocation counts (shared by all contexts, as the allocator itself is)
+    for (int tag = 0; tag < ImGuiMemTag_COUNT; tag++)
+    {
+        // Subtract rather than clear, allocations made by other threads in the meantime are counted for the next frame
+        const int frame_allocs = ImAtomicAdd(&GImMemTagStats[tag].CurrFrameAllocs, 0);
+        ImAtomicAdd(&GImMemTagStats[tag].CurrFrameAllocs, -frame_allocs);
+        GImMemTagStats[tag].FrameAllocs = frame_allocs;
+    }
+#endif
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
 
@@ -3760,6 +4622,10 @@ void ImGui::NewFrame()
     // Mark all windows as not visible and compact unused memory.
     IM_ASSERT(g.WindowsFocusOrder.Size == g.Windows.Size);
     const float memory_compact_start_time = (g.IO.ConfigWindowsMemoryCompactTimer >= 0.0f) ? (float)g.Time - g.IO.ConfigWindowsMemoryCompactTimer : FLT_MAX;
+    g.MemoryShrinkTimer += g.IO.DeltaTime;
+    const bool memory_shrink_draw_lists = (g.IO.ConfigWindowsMemoryCompactTimer >= 0.0f) && (g.MemoryShrinkTimer >= WINDOWS_MEMORY_SHRINK_TIMER);
+    if (memory_shrink_draw_lists)
+        g.MemoryShrinkTimer = 0.0f;
     for (int i = 0; i != g.Windows.Size; i++)
     {
         ImGuiWindow* window = g.Windows[i];
@@ -3771,6 +4637,15 @@ void ImGui::NewFrame()
         // Garbage collect transient buffers of recently unused windows
         if (!window->WasActive && !window->MemoryCompacted && window->LastTimeActive < memory_compact_start_time)
             GcCompactTransientWindowBuffers(window);
+
+        // Track the high water mark of draw lists and periodically shrink those which spiked
+        if (window->WasActive)
+        {
+            window->MemoryDrawListIdxHighWater = ImMax(window->MemoryDrawListIdxHighWater, window->DrawList->IdxBuffer.Size);
+            window->MemoryDrawListVtxHighWater = ImMax(window->MemoryDrawListVtxHighWater, window->DrawList->VtxBuffer.Size);
+        }
+        if (memory_shrink_draw_lists && !window->MemoryCompacted)
+            GcShrinkWindowDrawList(window);
     }
 
     // Closing the focused window restore focus to the first active root window in descending z-order
@@ -3837,6 +4712,21 @@ void ImGui::Initialize(ImGuiContext* context)
         ini_handler.ReadOpenFn = WindowSettingsHandler_ReadOpen;
         ini_handler.ReadLineFn = WindowSettingsHandler_ReadLine;
         ini_handler.WriteAllFn = WindowSettingsHandler_WriteAll;
+        ini_handler.ReadBinaryFn = WindowSettingsHandler_ReadBinary;
+        ini_handler.WriteBinaryFn = WindowSettingsHandler_WriteBinary;
+        ini_handler.CacheOutput = true;
+        g.SettingsHandlers.push_back(ini_handler);
+    }
+
+    // Add .ini handle for ImGuiDataTable type
+    {
+        ImGuiSettingsHandler ini_handler;
+        ini_handler.TypeName = "DataTable";
+        ini_handler.TypeHash = ImHashStr("DataTable");
+        ini_handler.ReadOpenFn = DataTableSettingsHandler_ReadOpen;
+        ini_handler.ReadLineFn = DataTableSettingsHandler_ReadLine;
+        ini_handler.WriteAllFn = DataTableSettingsHandler_WriteAll;
+        ini_handler.CacheOutput = true;
         g.SettingsHandlers.push_back(ini_handler);
     }
 
@@ -3883,6 +4773,7 @@ void ImGui::Shutdown(ImGuiContext* context)
         SaveIniSettingsToDisk(g.IO.IniFilename);
         SetCurrentContext(backup_context);
     }
+    UpdateSettingsSaveTask(&g, true);
 
     // Clear everything else
     for (int i = 0; i < g.Windows.Size; i++)
@@ -3909,12 +4800,23 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.TabBars.Clear();
     g.CurrentTabBarStack.clear();
     g.ShrinkWidthBuffer.clear();
+    g.Plots.Clear();
+    g.ListClippers.Clear();
+    g.TreeClippers.Clear();
 
     g.PrivateClipboard.clear();
     g.InputTextState.ClearFreeMemory();
+    g.FrameArena.clear();
 
     g.SettingsWindows.clear();
+    g.SettingsWindowsById.Clear();
+    g.SettingsDataTables.clear();
+    g.SettingsDataTablesById.Clear();
     g.SettingsHandlers.clear();
+    for (int n = 0; n < g.SettingsHandlersCache.Size; n++)
+        g.SettingsHandlersCache[n].~ImGuiSettingsHandlerCache();
+    g.SettingsHandlersCache.clear();
+    g.SettingsIniDataBinary.clear();
 
     if (g.LogFile)
     {
@@ -3960,6 +4862,7 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
 
 static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     if (draw_list->CmdBuffer.empty())
         return;
 
@@ -4766,6 +5669,7 @@ ImGuiWindow* ImGui::FindWindowByName(const char* name)
 
 static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Window);
     ImGuiContext& g = *GImGui;
     //IMGUI_DEBUG_LOG("CreateNewWindow '%s', flags = 0x%08X\n", name, flags);
 
@@ -4779,6 +5683,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
 
     // User can disable loading and saving of settings. Tooltip and child windows also don't store settings.
     if (!(flags & ImGuiWindowFlags_NoSavedSettings))
+    {
         if (ImGuiWindowSettings* settings = ImGui::FindWindowSettings(window->ID))
         {
             // Retrieve settings from .ini file
@@ -4789,6 +5694,12 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
             if (settings->Size.x > 0 && settings->Size.y > 0)
                 size = ImVec2(settings->Size.x, settings->Size.y);
         }
+        else if (ImGuiSettingsHandler* handler = ImGui::FindSettingsHandler("Window"))
+        {
+            // New entry: make sure the next save doesn't reuse the previous output of the handler
+            handler->Dirty = true;
+        }
+    }
     window->Size = window->SizeFull = ImFloor(size);
     window->DC.CursorStartPos = window->DC.CursorMaxPos = window->Pos; // So first call to CalcContentSize() doesn't return crazy values
 
@@ -5326,6 +6237,7 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
 // - Passing 'bool* p_open' displays a Close button on the upper-right corner of the window, the pointed value will be set to false when the button is pressed.
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Window);
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
@@ -5939,6 +6851,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
 void ImGui::End()
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Window);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
 
@@ -9437,23 +10350,49 @@ void ImGui::LogButtons()
 // [SECTION] SETTINGS
 //-----------------------------------------------------------------------------
 
+// Binary .ini format:
+// - Header: magic (4 bytes, the first one is not valid UTF-8 so text data can't be mistaken for it), version (u32).
+// - Followed by one section per handler: type hash (u32), kind (u8: 0 = text written by WriteAllFn, 1 = data written by WriteBinaryFn), size (u32), data.
+// Integers are little-endian.
+static const char   INI_BINARY_MAGIC[4] = { (char)0x89, 'I', 'N', 'I' };
+static const ImU32  INI_BINARY_VERSION = 1;
+static const size_t INI_BINARY_HEADER_SIZE = 8;
+static const size_t INI_BINARY_SECTION_HEADER_SIZE = 9;
+
+static void     IniBinaryWriteU16(ImVector<char>* buf, ImU32 v) { buf->push_back((char)(v & 0xFF)); buf->push_back((char)((v >> 8) & 0xFF)); }
+static void     IniBinaryWriteU32(ImVector<char>* buf, ImU32 v) { IniBinaryWriteU16(buf, v & 0xFFFF); IniBinaryWriteU16(buf, v >> 16); }
+static void     IniBinaryWriteData(ImVector<char>* buf, const void* data, size_t size) { if (size == 0) return; const int off = buf->Size; buf->resize(off + (int)size); memcpy(buf->Data + off, data, size); }
+static ImU32    IniBinaryReadU16(const char* p) { const unsigned char* s = (const unsigned char*)p; return (ImU32)s[0] | ((ImU32)s[1] << 8); }
+static ImU32    IniBinaryReadU32(const char* p) { return IniBinaryReadU16(p) | (IniBinaryReadU16(p + 2) << 16); }
+
 void ImGui::MarkIniSettingsDirty()
 {
     ImGuiContext& g = *GImGui;
+    for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+        g.SettingsHandlers[handler_n].Dirty = true;
     if (g.SettingsDirtyTimer <= 0.0f)
         g.SettingsDirtyTimer = g.IO.IniSavingRate;
 }
 
 void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 {
-    ImGuiContext& g = *GImGui;
     if (!(window->Flags & ImGuiWindowFlags_NoSavedSettings))
-        if (g.SettingsDirtyTimer <= 0.0f)
-            g.SettingsDirtyTimer = g.IO.IniSavingRate;
+        if (ImGuiSettingsHandler* handler = FindSettingsHandler("Window"))
+            MarkIniSettingsDirty(handler);
+}
+
+// Only the given handler will be asked to write its data again, the last output of other handlers with CacheOutput is reused.
+void ImGui::MarkIniSettingsDirty(ImGuiSettingsHandler* handler)
+{
+    ImGuiContext& g = *GImGui;
+    handler->Dirty = true;
+    if (g.SettingsDirtyTimer <= 0.0f)
+        g.SettingsDirtyTimer = g.IO.IniSavingRate;
 }
 
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
     ImGuiContext& g = *GImGui;
 
 #if !IMGUI_DEBUG_INI_SETTINGS
@@ -9470,6 +10409,7 @@ ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
     IM_PLACEMENT_NEW(settings) ImGuiWindowSettings();
     settings->ID = ImHashStr(name, name_len);
     memcpy(settings->GetName(), name, name_len + 1);   // Store with zero terminator
+    g.SettingsWindowsById.SetInt(settings->ID, g.SettingsWindows.offset_from_ptr(settings));
 
     return settings;
 }
@@ -9477,10 +10417,8 @@ ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
 ImGuiWindowSettings* ImGui::FindWindowSettings(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
-        if (settings->ID == id)
-            return settings;
-    return NULL;
+    const int offset = g.SettingsWindowsById.GetInt(id, 0); // Valid offsets are never 0 as they skip the chunk header
+    return offset ? g.SettingsWindows.ptr_from_offset(offset) : NULL;
 }
 
 ImGuiWindowSettings* ImGui::FindOrCreateWindowSettings(const char* name)
@@ -9490,6 +10428,32 @@ ImGuiWindowSettings* ImGui::FindOrCreateWindowSettings(const char* name)
     return CreateNewWindowSettings(name);
 }
 
+// Offsets are initialized to equal widths. An existing entry with the same ID is superseded.
+ImGuiDataTableSettings* ImGui::CreateDataTableSettings(ImGuiID id, int columns_count)
+{
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(id != 0 && columns_count >= 1);
+    if (ImGuiDataTableSettings* old_settings = FindDataTableSettings(id))
+        old_settings->ID = 0;
+
+    ImGuiDataTableSettings* settings = g.SettingsDataTables.alloc_chunk(sizeof(ImGuiDataTableSettings) + sizeof(float) * (columns_count + 1));
+    IM_PLACEMENT_NEW(settings) ImGuiDataTableSettings();
+    settings->ID = id;
+    settings->ColumnsCount = columns_count;
+    for (int n = 0; n < columns_count + 1; n++)
+        settings->GetOffsets()[n] = n / (float)columns_count;
+    g.SettingsDataTablesById.SetInt(id, g.SettingsDataTables.offset_from_ptr(settings));
+    return settings;
+}
+
+ImGuiDataTableSettings* ImGui::FindDataTableSettings(ImGuiID id)
+{
+    ImGuiContext& g = *GImGui;
+    const int offset = g.SettingsDataTablesById.GetInt(id, 0);
+    return offset ? g.SettingsDataTables.ptr_from_offset(offset) : NULL;
+}
+
 void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
 {
     size_t file_data_size = 0;
@@ -9500,32 +10464,25 @@ void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
     IM_FREE(file_data);
 }
 
-ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
+static ImGuiSettingsHandler* FindSettingsHandlerByHash(ImGuiID type_hash)
 {
     ImGuiContext& g = *GImGui;
-    const ImGuiID type_hash = ImHashStr(type_name);
     for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
         if (g.SettingsHandlers[handler_n].TypeHash == type_hash)
             return &g.SettingsHandlers[handler_n];
     return NULL;
 }
 
+ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
+{
+    return FindSettingsHandlerByHash(ImHashStr(type_name));
+}
+
 // Zero-tolerance, no error reporting, cheap .ini parsing
-void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
+// We write zero-terminators within the buffer, so it needs to be a writable copy, zero-terminated at 'buf_end'.
+static void LoadIniSettingsFromText(char* buf, char* buf_end)
 {
     ImGuiContext& g = *GImGui;
-    IM_ASSERT(g.Initialized);
-    IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
-
-    // For user convenience, we allow passing a non zero-terminated string (hence the ini_size parameter).
-    // For our convenience and to make the code simpler, we'll also write zero-terminators within the buffer. So let's create a writable copy..
-    if (ini_size == 0)
-        ini_size = strlen(ini_data);
-    char* buf = (char*)IM_ALLOC(ini_size + 1);
-    char* buf_end = buf + ini_size;
-    memcpy(buf, ini_data, ini_size);
-    buf[ini_size] = 0;
-
     void* entry_data = NULL;
     ImGuiSettingsHandler* entry_handler = NULL;
 
@@ -9553,7 +10510,7 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
                 continue;
             *type_end = 0; // Overwrite first ']'
             name_start++;  // Skip second '['
-            entry_handler = FindSettingsHandler(type_start);
+            entry_handler = ImGui::FindSettingsHandler(type_start);
             entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start) : NULL;
         }
         else if (entry_handler != NULL && entry_data != NULL)
@@ -9562,7 +10519,64 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
             entry_handler->ReadLineFn(&g, entry_handler, entry_data, line);
         }
     }
-    IM_FREE(buf);
+}
+
+// Sections of unknown handlers and truncated data are skipped
+static void LoadIniSettingsFromBinary(const char* data, size_t data_size)
+{
+    ImGuiContext& g = *GImGui;
+    const char* data_end = data + data_size;
+    if (IniBinaryReadU32(data + 4) != INI_BINARY_VERSION)
+        return;
+    for (const char* p = data + INI_BINARY_HEADER_SIZE; (size_t)(data_end - p) >= INI_BINARY_SECTION_HEADER_SIZE; )
+    {
+        const ImU32 type_hash = IniBinaryReadU32(p);
+        const bool is_text = (p[4] == 0);
+        const size_t section_size = (size_t)IniBinaryReadU32(p + 5);
+        p += INI_BINARY_SECTION_HEADER_SIZE;
+        if (section_size > (size_t)(data_end - p))
+            break;
+        if (is_text)
+        {
+            // Text sections are self-describing ("[Type][Name]" headers)
+            char* buf = (char*)IM_ALLOC(section_size + 1);
+            memcpy(buf, p, section_size);
+            buf[section_size] = 0;
+            LoadIniSettingsFromText(buf, buf + section_size);
+            IM_FREE(buf);
+        }
+        else if (ImGuiSettingsHandler* handler = FindSettingsHandlerByHash(type_hash))
+        {
+            if (handler->ReadBinaryFn)
+                handler->ReadBinaryFn(&g, handler, p, p + section_size);
+        }
+        p += section_size;
+    }
+}
+
+void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
+{
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.Initialized);
+    IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
+
+    // For user convenience, we allow passing a non zero-terminated string (hence the ini_size parameter).
+    if (ini_size == 0)
+        ini_size = strlen(ini_data);
+    if (ini_size >= INI_BINARY_HEADER_SIZE && memcmp(ini_data, INI_BINARY_MAGIC, sizeof(INI_BINARY_MAGIC)) == 0)
+    {
+        LoadIniSettingsFromBinary(ini_data, ini_size);
+    }
+    else
+    {
+        // For our convenience and to make the code simpler, we'll also write zero-terminators within the buffer. So let's create a writable copy..
+        char* buf = (char*)IM_ALLOC(ini_size + 1);
+        memcpy(buf, ini_data, ini_size);
+        buf[ini_size] = 0;
+        LoadIniSettingsFromText(buf, buf + ini_size);
+        IM_FREE(buf);
+    }
     g.SettingsLoaded = true;
 }
 
@@ -9573,32 +10587,215 @@ void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
     if (!ini_filename)
         return;
 
+    // Don't let an older asynchronous save land after this one
+    UpdateSettingsSaveTask(&g, true);
+
     size_t ini_data_size = 0;
-    const char* ini_data = SaveIniSettingsToMemory(&ini_data_size);
-    ImFileHandle f = ImFileOpen(ini_filename, "wt");
-    if (!f)
-        return;
-    ImFileWrite(ini_data, sizeof(char), ini_data_size, f);
-    ImFileClose(f);
+    const bool binary = g.IO.IniSaveBinary;
+    const void* ini_data = binary ? SaveIniSettingsToMemoryBinary(&ini_data_size) : (const void*)SaveIniSettingsToMemory(&ini_data_size);
+    ImGuiSettingsSaveTask task;
+    task.Filename = ini_filename;
+    task.TempFilename = NULL;
+    task.Data = ini_data;
+    task.DataSize = ini_data_size;
+    task.Binary = binary;
+    SettingsSaveTaskWrite(&task);
+}
+
+bool ImGui::SaveIniSettingsToDiskAsync(const char* ini_filename)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.IO.IniSaveAsync != NULL);
+    if (!UpdateSettingsSaveTask(&g, false))
+        return false;
+    g.SettingsDirtyTimer = 0.0f;
+    if (!ini_filename)
+        return true;
+
+    // Serialize on this thread, the task only touches its own copy of the data
+    size_t ini_data_size = 0;
+    const bool binary = g.IO.IniSaveBinary;
+    const void* ini_data = binary ? SaveIniSettingsToMemoryBinary(&ini_data_size) : (const void*)SaveIniSettingsToMemory(&ini_data_size);
+    const size_t filename_size = strlen(ini_filename) + 1;
+    const char temp_suffix[] = ".tmp";
+    ImGuiSettingsSaveTask* task = (ImGuiSettingsSaveTask*)IM_ALLOC(sizeof(ImGuiSettingsSaveTask) + ini_data_size + filename_size * 2 + sizeof(temp_suffix));
+    char* p = (char*)(task + 1);
+    task->Data = p;
+    memcpy(p, ini_data, ini_data_size);
+    p += ini_data_size;
+    task->Filename = p;
+    memcpy(p, ini_filename, filename_size);
+    p += filename_size;
+    task->TempFilename = p;
+    memcpy(p, ini_filename, filename_size - 1);
+    memcpy(p + filename_size - 1, temp_suffix, sizeof(temp_suffix));
+    task->DataSize = ini_data_size;
+    task->Binary = binary;
+    task->State = ImGuiAsyncTaskState_Pending;
+    g.SettingsSaveTask = task;
+    g.IO.IniSaveAsync(SettingsSaveTaskFunc, task, g.IO.IniSaveAsyncUserData);
+    return true;
+}
+
+// May run on another thread: only touches the task and the file functions, which don't use the context
+static void SettingsSaveTaskWrite(ImGuiSettingsSaveTask* task)
+{
+#ifdef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
+    const char* write_filename = task->Filename;
+#else
+    const char* write_filename = task->TempFilename ? task->TempFilename : task->Filename;
+#endif
+    if (ImFileHandle f = ImFileOpen(write_filename, task->Binary ? "wb" : "wt"))
+    {
+        const bool written = ImFileWrite(task->Data, sizeof(char), task->DataSize, f) == task->DataSize;
+        if (ImFileClose(f) && written && write_filename != task->Filename)
+            ImFileRename(write_filename, task->Filename);
+    }
+}
+
+// Passed to io.IniSaveAsync. If UpdateSettingsSaveTask() claimed the task to write the file while waiting for us, we don't write it again (see ImGuiAsyncTaskState).
+static void SettingsSaveTaskFunc(void* task_data)
+{
+    ImGuiSettingsSaveTask* task = (ImGuiSettingsSaveTask*)task_data;
+    const long state = ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Pending, ImGuiAsyncTaskState_Running);
+    if (state == ImGuiAsyncTaskState_Pending)
+    {
+        SettingsSaveTaskWrite(task);
+        ImAtomicStore(&task->State, ImGuiAsyncTaskState_Done);
+    }
+    else if (state == ImGuiAsyncTaskState_Claimed && ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Claimed, ImGuiAsyncTaskState_Done) == ImGuiAsyncTaskState_Claimed)
+    {
+        // Still being written by UpdateSettingsSaveTask(), which will free it
+    }
+    else
+    {
+        IM_ASSERT(ImAtomicLoad(&task->State) == ImGuiAsyncTaskState_Orphaned);
+        IM_FREE(task);
+    }
+}
+
+// Release the asynchronous save task once it completed, optionally waiting for it. Return true if no save is in flight.
+// When waiting on a task which didn't start yet, write the file here instead: io.IniSaveAsync may have queued it to this very thread.
+static bool UpdateSettingsSaveTask(ImGuiContext* ctx, bool wait)
+{
+    ImGuiContext& g = *ctx;
+    ImGuiSettingsSaveTask* task = g.SettingsSaveTask;
+    if (task == NULL)
+        return true;
+    if (wait && ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Pending, ImGuiAsyncTaskState_Claimed) == ImGuiAsyncTaskState_Pending)
+    {
+        SettingsSaveTaskWrite(task);
+        if (ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Claimed, ImGuiAsyncTaskState_Orphaned) != ImGuiAsyncTaskState_Claimed)
+            IM_FREE(task); // SettingsSaveTaskFunc() was called meanwhile, otherwise the pending call will free the task
+        g.SettingsSaveTask = NULL;
+        return true;
+    }
+    while (ImAtomicLoad(&task->State) != ImGuiAsyncTaskState_Done)
+        if (!wait)
+            return false;
+    IM_FREE(task);
+    g.SettingsSaveTask = NULL;
+    return true;
+}
+
+// Keep g.SettingsHandlersCache[] parallel to g.SettingsHandlers[] (which users may append to) and drop the output of dirty handlers
+// and of handlers which didn't opt in with CacheOutput (we can't know when their data changes)
+static void UpdateSettingsHandlersCache()
+{
+    ImGuiContext& g = *GImGui;
+
+    // Windows can be moved, resized or collapsed without MarkIniSettingsDirty() (e.g. SetWindowPos(), auto-fit, clamping to the display): compare them with their entries
+    if (WindowSettingsHandler_UpdateSettings(&g))
+        if (ImGuiSettingsHandler* handler = ImGui::FindSettingsHandler("Window"))
+            handler->Dirty = true;
+
+    while (g.SettingsHandlersCache.Size < g.SettingsHandlers.Size)
+        g.SettingsHandlersCache.push_back(ImGuiSettingsHandlerCache());
+    for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+    {
+        ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+        ImGuiSettingsHandlerCache* cache = &g.SettingsHandlersCache[handler_n];
+        if (!handler->CacheOutput || handler->Dirty || cache->TypeHash != handler->TypeHash)
+            cache->TextValid = cache->BinaryValid = false;
+        cache->TypeHash = handler->TypeHash;
+        handler->Dirty = false;
+    }
+}
+
+static ImGuiTextBuffer* GetSettingsHandlerText(int handler_n)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+    ImGuiSettingsHandlerCache* cache = &g.SettingsHandlersCache[handler_n];
+    if (!cache->TextValid)
+    {
+        cache->Text.Buf.resize(0);
+        handler->WriteAllFn(&g, handler, &cache->Text);
+        cache->TextValid = true;
+    }
+    return &cache->Text;
 }
 
 // Call registered handlers (e.g. SettingsHandlerWindow_WriteAll() + custom handlers) to write their stuff into a text buffer
+// Handlers with CacheOutput which were not marked dirty since the last save are not called again.
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
+    UpdateSettingsHandlersCache();
     g.SettingsIniData.Buf.resize(0);
     g.SettingsIniData.Buf.push_back(0);
     for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
     {
-        ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
-        handler->WriteAllFn(&g, handler, &g.SettingsIniData);
+        ImGuiTextBuffer* text = GetSettingsHandlerText(handler_n);
+        if (!text->empty())
+            g.SettingsIniData.append(text->begin(), text->end());
     }
     if (out_size)
         *out_size = (size_t)g.SettingsIniData.size();
     return g.SettingsIniData.c_str();
 }
 
+// Same as SaveIniSettingsToMemory() but output the binary format, using WriteBinaryFn for handlers which have one
+const void* ImGui::SaveIniSettingsToMemoryBinary(size_t* out_size)
+{
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
+    ImGuiContext& g = *GImGui;
+    g.SettingsDirtyTimer = 0.0f;
+    UpdateSettingsHandlersCache();
+    ImVector<char>* buf = &g.SettingsIniDataBinary;
+    buf->resize(0);
+    IniBinaryWriteData(buf, INI_BINARY_MAGIC, sizeof(INI_BINARY_MAGIC));
+    IniBinaryWriteU32(buf, INI_BINARY_VERSION);
+    for (int handler_n = 0; handler_n < g.SettingsHandlers.Size; handler_n++)
+    {
+        ImGuiSettingsHandler* handler = &g.SettingsHandlers[handler_n];
+        ImGuiSettingsHandlerCache* cache = &g.SettingsHandlersCache[handler_n];
+        if (!cache->BinaryValid)
+        {
+            cache->Binary.resize(0);
+            if (handler->WriteBinaryFn)
+            {
+                handler->WriteBinaryFn(&g, handler, &cache->Binary);
+            }
+            else
+            {
+                ImGuiTextBuffer* text = GetSettingsHandlerText(handler_n);
+                IniBinaryWriteData(&cache->Binary, text->begin(), (size_t)text->size());
+            }
+            cache->BinaryValid = true;
+        }
+        IniBinaryWriteU32(buf, handler->TypeHash);
+        buf->push_back(handler->WriteBinaryFn ? 1 : 0);
+        IniBinaryWriteU32(buf, (ImU32)cache->Binary.Size);
+        IniBinaryWriteData(buf, cache->Binary.Data, (size_t)cache->Binary.Size);
+    }
+    if (out_size)
+        *out_size = (size_t)buf->Size;
+    return buf->Data;
+}
+
 static void* WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
 {
     ImGuiWindowSettings* settings = ImGui::FindWindowSettings(ImHashStr(name));
@@ -9617,11 +10814,13 @@ static void WindowSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*,
     else if (sscanf(line, "Collapsed=%d", &i) == 1)     settings->Collapsed = (i != 0);
 }
 
-static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+// Gather data from windows that were active during this session
+// (if a window wasn't opened in this session we preserve its settings)
+// Copy the state of windows into their settings entries, return true if any entry was created or changed
+static bool WindowSettingsHandler_UpdateSettings(ImGuiContext* ctx)
 {
-    // Gather data from windows that were active during this session
-    // (if a window wasn't opened in this session we preserve its settings)
     ImGuiContext& g = *ctx;
+    bool changed = false;
     for (int i = 0; i != g.Windows.Size; i++)
     {
         ImGuiWindow* window = g.Windows[i];
@@ -9633,23 +10832,116 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
         {
             settings = ImGui::CreateNewWindowSettings(window->Name);
             window->SettingsOffset = g.SettingsWindows.offset_from_ptr(settings);
+            changed = true;
         }
         IM_ASSERT(settings->ID == window->ID);
-        settings->Pos = ImVec2ih((short)window->Pos.x, (short)window->Pos.y);
-        settings->Size = ImVec2ih((short)window->SizeFull.x, (short)window->SizeFull.y);
+        const ImVec2ih pos((short)window->Pos.x, (short)window->Pos.y);
+        const ImVec2ih size((short)window->SizeFull.x, (short)window->SizeFull.y);
+        if (settings->Pos.x != pos.x || settings->Pos.y != pos.y || settings->Size.x != size.x || settings->Size.y != size.y || settings->Collapsed != window->Collapsed)
+            changed = true;
+        settings->Pos = pos;
+        settings->Size = size;
         settings->Collapsed = window->Collapsed;
     }
+    return changed;
+}
+
+static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *ctx;
+    WindowSettingsHandler_UpdateSettings(ctx);
 
     // Write to text buffer
     buf->reserve(buf->size() + g.SettingsWindows.size() * 6); // ballpark reserve
     for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
     {
         const char* settings_name = settings->GetName();
-        buf->appendf("[%s][%s]\n", handler->TypeName, settings_name);
-        buf->appendf("Pos=%d,%d\n", settings->Pos.x, settings->Pos.y);
-        buf->appendf("Size=%d,%d\n", settings->Size.x, settings->Size.y);
-        buf->appendf("Collapsed=%d\n", settings->Collapsed);
-        buf->append("\n");
+        buf->appendf("[%s][%s]\nPos=%d,%d\nSize=%d,%d\nCollapsed=%d\n\n", handler->TypeName, settings_name, settings->Pos.x, settings->Pos.y, settings->Size.x, settings->Size.y, settings->Collapsed);
+    }
+}
+
+// Binary entries: name length (u16), name, Pos.x, Pos.y, Size.x, Size.y (s16), Collapsed (u8)
+static void WindowSettingsHandler_ReadBinary(ImGuiContext*, ImGuiSettingsHandler*, const char* data, const char* data_end)
+{
+    ImVector<char> name;
+    while (data_end - data >= 2)
+    {
+        const int name_len = (int)IniBinaryReadU16(data);
+        if (data_end - data < 2 + name_len + 9)
+            break;
+        name.resize(name_len + 1);
+        memcpy(name.Data, data + 2, (size_t)name_len);
+        name[name_len] = 0;
+        data += 2 + name_len;
+
+        ImGuiWindowSettings* settings = ImGui::FindWindowSettings(ImHashStr(name.Data));
+        if (!settings)
+            settings = ImGui::CreateNewWindowSettings(name.Data);
+        settings->Pos = ImVec2ih((short)IniBinaryReadU16(data), (short)IniBinaryReadU16(data + 2));
+        settings->Size = ImVec2ih((short)IniBinaryReadU16(data + 4), (short)IniBinaryReadU16(data + 6));
+        settings->Collapsed = (data[8] != 0);
+        data += 9;
+    }
+}
+
+static void WindowSettingsHandler_WriteBinary(ImGuiContext* ctx, ImGuiSettingsHandler*, ImVector<char>* buf)
+{
+    ImGuiContext& g = *ctx;
+    WindowSettingsHandler_UpdateSettings(ctx);
+    for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
+    {
+        const char* settings_name = settings->GetName();
+        const size_t name_len = ImMin(strlen(settings_name), (size_t)0xFFFF);
+        IniBinaryWriteU16(buf, (ImU32)name_len);
+        IniBinaryWriteData(buf, settings_name, name_len);
+        IniBinaryWriteU16(buf, (ImU32)(ImU16)settings->Pos.x);
+        IniBinaryWriteU16(buf, (ImU32)(ImU16)settings->Pos.y);
+        IniBinaryWriteU16(buf, (ImU32)(ImU16)settings->Size.x);
+        IniBinaryWriteU16(buf, (ImU32)(ImU16)settings->Size.y);
+        buf->push_back(settings->Collapsed ? 1 : 0);
+    }
+}
+
+// Entries are named after the ID and the columns count, e.g. "[DataTable][0x1234ABCD,3]"
+static void* DataTableSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
+{
+    ImU32 id = 0;
+    int columns_count = 0;
+    if (sscanf(name, "0x%08X,%d", &id, &columns_count) < 2 || id == 0 || columns_count < 1 || columns_count > 64)
+        return NULL;
+    return (void*)ImGui::CreateDataTableSettings(id, columns_count);
+}
+
+static void DataTableSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line)
+{
+    ImGuiDataTableSettings* settings = (ImGuiDataTableSettings*)entry;
+    if (strncmp(line, "Offsets=", 8) != 0)
+        return;
+    line += 8;
+    for (int n = 0; n < settings->ColumnsCount + 1; n++)
+    {
+        float offset;
+        int len = 0;
+        if (sscanf(line, "%f%n", &offset, &len) < 1)
+            break;
+        settings->GetOffsets()[n] = ImSaturate(offset);
+        line += len;
+        if (*line == ',')
+            line++;
+    }
+}
+
+static void DataTableSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *ctx;
+    for (ImGuiDataTableSettings* settings = g.SettingsDataTables.begin(); settings != NULL; settings = g.SettingsDataTables.next_chunk(settings))
+    {
+        if (settings->ID == 0)
+            continue;
+        buf->appendf("[%s][0x%08X,%d]\nOffsets=", handler->TypeName, settings->ID, settings->ColumnsCount);
+        for (int n = 0; n < settings->ColumnsCount + 1; n++)
+            buf->appendf(n ? ",%.4f" : "%.4f", settings->GetOffsets()[n]);
+        buf->append("\n\n");
     }
 }
 
@@ -9672,7 +10964,8 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
 // [SECTION] PLATFORM DEPENDENT HELPERS
 //-----------------------------------------------------------------------------
 
-#if defined(_WIN32) && !defined(_WINDOWS_) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS))
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS))
+#ifndef _WINDOWS_ // May already be included by the default file functions
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
@@ -9681,6 +10974,7 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
 #else
 #include <windows.h>
 #endif
+#endif
 #if defined(WINAPI_FAMILY) && (WINAPI_FAMILY == WINAPI_FAMILY_APP) // UWP doesn't have Win32 functions
 #define IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS
 #define IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS
@@ -10172,6 +11466,46 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     }
 #endif // #define IMGUI_HAS_DOCK
 
+    // Details for Memory (accounted per subsystem, shared by all contexts)
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    if (ImGui::TreeNode("Memory"))
+    {
+        ImGui::Columns(6, "##memtags", true);
+        ImGui::Text("Tag"); ImGui::NextColumn();
+        ImGui::Text("Bytes"); ImGui::NextColumn();
+        ImGui::Text("Peak"); ImGui::NextColumn();
+        ImGui::Text("Allocs"); ImGui::NextColumn();
+        ImGui::Text("Frame"); ImGui::NextColumn();
+        ImGui::Text("Total"); ImGui::NextColumn();
+        ImGui::Separator();
+        ImGuiMemTagStats total;
+        memset(&total, 0, sizeof(total));
+        for (int tag = 0; tag < ImGuiMemTag_COUNT; tag++)
+        {
+            const ImGuiMemTagStats* stats = ImGui::GetMemTagStats(tag);
+            ImGui::Text("%s", ImGui::GetMemTagName(tag)); ImGui::NextColumn();
+            ImGui::Text("%d", (int)stats->Bytes); ImGui::NextColumn();
+            ImGui::Text("%d", (int)stats->PeakBytes); ImGui::NextColumn();
+            ImGui::Text("%d", stats->Allocs); ImGui::NextColumn();
+            ImGui::Text("%d", stats->FrameAllocs); ImGui::NextColumn();
+            ImGui::Text("%d", stats->TotalAllocs); ImGui::NextColumn();
+            total.Bytes += stats->Bytes;
+            total.Allocs += stats->Allocs;
+            total.FrameAllocs += stats->FrameAllocs;
+            total.TotalAllocs += stats->TotalAllocs;
+        }
+        ImGui::Separator();
+        ImGui::Text("Total"); ImGui::NextColumn();
+        ImGui::Text("%d", (int)total.Bytes); ImGui::NextColumn();
+        ImGui::Text("-"); ImGui::NextColumn();
+        ImGui::Text("%d", total.Allocs); ImGui::NextColumn();
+        ImGui::Text("%d", total.FrameAllocs); ImGui::NextColumn();
+        ImGui::Text("%d", total.TotalAllocs); ImGui::NextColumn();
+        ImGui::Columns(1);
+        ImGui::TreePop();
+    }
+#endif
+
     // Misc Details
     if (ImGui::TreeNode("Internal state"))
     {
@@ -10190,6 +11524,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("NavDisableHighlight: %d, NavDisableMouseHover: %d", g.NavDisableHighlight, g.NavDisableMouseHover);
         ImGui::Text("NavWindowingTarget: '%s'", g.NavWindowingTarget ? g.NavWindowingTarget->Name : "NULL");
         ImGui::Text("DragDrop: %d, SourceId = 0x%08X, Payload \"%s\" (%d bytes)", g.DragDropActive, g.DragDropPayload.SourceId, g.DragDropPayload.DataType, g.DragDropPayload.DataSize);
+        ImGui::Text("FrameArena: %d blocks, %d bytes, %d allocs this frame", g.FrameArena.Blocks.Size, g.FrameArena.capacity(), g.FrameArena.AllocCount);
         ImGui::TreePop();
     }
 
@@ -10202,6 +11537,11 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::SameLine();
         MetricsHelpMarker("Will call the IM_DEBUG_BREAK() macro to break in debugger.\nWarning: If you don't have a debugger attached, this will probably crash.");
 
+        if (ImGui::Button("Compact Memory"))
+            ImGui::CompactMemory(ImGuiCompactLevel_Medium);
+        ImGui::SameLine();
+        MetricsHelpMarker("Will call CompactMemory(ImGuiCompactLevel_Medium) to shrink buffers to their current usage.");
+
         ImGui::Checkbox("Show windows begin order", &show_windows_begin_order);
         ImGui::Checkbox("Show windows rectangles", &show_windows_rects);
         ImGui::SameLine();
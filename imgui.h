@@ -29,7 +29,7 @@ Index of this file:
 // ImGuiIO
 // Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // Obsolete functions
-// Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
+// Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiTextLog, ImGuiStorage, ImGuiListClipper, ImGuiListClipperVariable, ImGuiTreeClipper, ImGuiPlotStream, ImGuiDataTable, ImColor)
 // Draw List API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
 // Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 
@@ -124,11 +124,15 @@ struct ImFontAtlas;                 // Runtime data for multiple fonts, bake mul
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
+struct ImGuiDataTable;              // Helper to hold typed columns of values and display them in a sortable, clipped table
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperVariable;    // Helper to manually clip large list of items of varying heights
+struct ImGuiPlotStream;             // Helper to hold the last N values pushed by a (possibly other) thread, for PlotLinesStream()/PlotHistogramStream()
+struct ImGuiMemTagStats;            // Memory usage of a subsystem, when IMGUI_ENABLE_MEMORY_TAGS is defined
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
@@ -136,6 +140,8 @@ struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbb][,ccccc]")
+struct ImGuiTextLog;                // Helper to hold, filter and display lines of text (e.g. a log)
+struct ImGuiTreeClipper;            // Helper to manually clip large trees of nodes
 
 // Typedefs and Enums/Flags (declared as int for compatibility with old C++, to allow using as flags and to not pollute the top of this file)
 // Use your programming IDE "Go to definition" facility on the names in the central column below to find the actual flags/enum lists.
@@ -147,8 +153,11 @@ typedef unsigned short ImWchar;     // A single U16 character for keyboard input
 typedef int ImGuiCol;               // -> enum ImGuiCol_             // Enum: A color identifier for styling
 typedef int ImGuiCond;              // -> enum ImGuiCond_            // Enum: A condition for many Set*() functions
 typedef int ImGuiDataType;          // -> enum ImGuiDataType_        // Enum: A primary data type
+typedef int ImGuiDataTableColumnType; // -> enum ImGuiDataTableColumnType_ // Enum: A column type for ImGuiDataTable
 typedef int ImGuiDir;               // -> enum ImGuiDir_             // Enum: A cardinal direction
 typedef int ImGuiKey;               // -> enum ImGuiKey_             // Enum: A key identifier (ImGui-side enum)
+typedef int ImGuiCompactLevel;      // -> enum ImGuiCompactLevel_    // Enum: How much memory CompactMemory() should release
+typedef int ImGuiMemTag;            // -> enum ImGuiMemTag_          // Enum: A subsystem identifier for memory accounting
 typedef int ImGuiNavInput;          // -> enum ImGuiNavInput_        // Enum: An input identifier for navigation
 typedef int ImGuiMouseButton;       // -> enum ImGuiMouseButton_     // Enum: A mouse button identifier (0=left, 1=right, 2=middle)
 typedef int ImGuiMouseCursor;       // -> enum ImGuiMouseCursor_     // Enum: A mouse cursor identifier
@@ -164,6 +173,7 @@ typedef int ImGuiDragDropFlags;     // -> enum ImGuiDragDropFlags_   // Flags: f
 typedef int ImGuiFocusedFlags;      // -> enum ImGuiFocusedFlags_    // Flags: for IsWindowFocused()
 typedef int ImGuiHoveredFlags;      // -> enum ImGuiHoveredFlags_    // Flags: for IsItemHovered(), IsWindowHovered() etc.
 typedef int ImGuiInputTextFlags;    // -> enum ImGuiInputTextFlags_  // Flags: for InputText(), InputTextMultiline()
+typedef int ImGuiPlotFlags;         // -> enum ImGuiPlotFlags_       // Flags: for PlotLines(), PlotHistogram()
 typedef int ImGuiSelectableFlags;   // -> enum ImGuiSelectableFlags_ // Flags: for Selectable()
 typedef int ImGuiTabBarFlags;       // -> enum ImGuiTabBarFlags_     // Flags: for BeginTabBar()
 typedef int ImGuiTabItemFlags;      // -> enum ImGuiTabItemFlags_    // Flags: for BeginTabItem()
@@ -171,6 +181,9 @@ typedef int ImGuiTreeNodeFlags;     // -> enum ImGuiTreeNodeFlags_   // Flags: f
 typedef int ImGuiWindowFlags;       // -> enum ImGuiWindowFlags_     // Flags: for Begin(), BeginChild()
 typedef int (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData *data);
 typedef void (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);
+typedef void (*ImFontAtlasParallelForFunc)(int tasks_count, void (*task_func)(void* task_data, int task_index), void* task_data, void* user_data);
+typedef void (*ImGuiRunAsyncFunc)(void (*task_func)(void* task_data), void* task_data, void* user_data);
+typedef void (*ImGuiTreeClipperGetter)(void* user_data, int node_idx, int* out_descendants_count, ImGuiID* out_id);
 
 // Scalar data types
 typedef signed char         ImS8;   // 8-bit signed integer
@@ -542,10 +555,14 @@ namespace ImGui
     IMGUI_API void          ListBoxFooter();                                                    // terminate the scrolling region. only call ListBoxFooter() if ListBoxHeader() returned true!
 
     // Widgets: Data Plotting
-    IMGUI_API void          PlotLines(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float));
-    IMGUI_API void          PlotLines(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
-    IMGUI_API void          PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float));
-    IMGUI_API void          PlotHistogram(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
+    IMGUI_API void          PlotLines(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float), ImGuiPlotFlags flags = 0);
+    IMGUI_API void          PlotLines(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), ImGuiPlotFlags flags = 0);
+    IMGUI_API void          PlotLinesScalar(const char* label, ImGuiDataType data_type, const void* p_values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = 0, ImGuiPlotFlags flags = 0);   // plot an array of any scalar type (stride 0 = tightly packed)
+    IMGUI_API void          PlotLinesStream(const char* label, ImGuiPlotStream* stream, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), ImGuiPlotFlags flags = 0);  // plot the history of a stream, scrolling as values are pushed. always decimated with ImGuiPlotFlags_Decimate.
+    IMGUI_API void          PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float), ImGuiPlotFlags flags = 0);
+    IMGUI_API void          PlotHistogram(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), ImGuiPlotFlags flags = 0);
+    IMGUI_API void          PlotHistogramScalar(const char* label, ImGuiDataType data_type, const void* p_values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = 0, ImGuiPlotFlags flags = 0);
+    IMGUI_API void          PlotHistogramStream(const char* label, ImGuiPlotStream* stream, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), ImGuiPlotFlags flags = 0);
 
     // Widgets: Value() Helpers.
     // - Those are merely shortcut to calling Text() with a format string. Output single value in "name: value" format (tip: freely declare more in your code to handle your types. you can add functions to the ImGui namespace)
@@ -723,9 +740,11 @@ namespace ImGui
     // - The disk functions are automatically called if io.IniFilename != NULL (default is "imgui.ini").
     // - Set io.IniFilename to NULL to load/save manually. Read io.WantSaveIniSettings description about handling .ini saving manually.
     IMGUI_API void          LoadIniSettingsFromDisk(const char* ini_filename);                  // call after CreateContext() and before the first call to NewFrame(). NewFrame() automatically calls LoadIniSettingsFromDisk(io.IniFilename).
-    IMGUI_API void          LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size=0); // call after CreateContext() and before the first call to NewFrame() to provide .ini data from your own data source.
+    IMGUI_API void          LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size=0); // call after CreateContext() and before the first call to NewFrame() to provide .ini data from your own data source. binary data (see SaveIniSettingsToMemoryBinary) is detected, ini_size is required for it.
     IMGUI_API void          SaveIniSettingsToDisk(const char* ini_filename);                    // this is automatically called (if io.IniFilename is not empty) a few seconds after any modification that should be reflected in the .ini file (and also by DestroyContext).
+    IMGUI_API bool          SaveIniSettingsToDiskAsync(const char* ini_filename);               // serialize now and write the file through io.IniSaveAsync. return false (and do nothing) if the previous asynchronous save is still in flight. this is automatically called instead of SaveIniSettingsToDisk() when io.IniSaveAsync is set.
     IMGUI_API const char*   SaveIniSettingsToMemory(size_t* out_ini_size = NULL);               // return a zero-terminated string with the .ini data which you can save by your own mean. call when io.WantSaveIniSettings is set, then save data by your own mean and clear io.WantSaveIniSettings.
+    IMGUI_API const void*   SaveIniSettingsToMemoryBinary(size_t* out_ini_size);                // same as SaveIniSettingsToMemory() in a compact binary format, which LoadIniSettingsFromMemory() also accepts.
 
     // Memory Allocators
     // - All those functions are not reliant on the current context.
@@ -733,6 +752,9 @@ namespace ImGui
     IMGUI_API void          SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data = NULL);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API const ImGuiMemTagStats* GetMemTagStats(ImGuiMemTag tag);                      // memory usage of a subsystem (draw lists, fonts, settings..). return NULL unless IMGUI_ENABLE_MEMORY_TAGS is defined in imconfig.h.
+    IMGUI_API const char*   GetMemTagName(ImGuiMemTag tag);
+    IMGUI_API void          CompactMemory(ImGuiCompactLevel level);                         // release memory held by buffers which will be regrown on demand, e.g. on memory pressure. when called between NewFrame() and Render() this is deferred to the next NewFrame().
 
 } // namespace ImGui
 
@@ -804,6 +826,7 @@ enum ImGuiInputTextFlags_
     ImGuiInputTextFlags_NoUndoRedo          = 1 << 16,  // Disable undo/redo. Note that input text owns the text data while active, if you want to provide your own undo/redo stack you need e.g. to call ClearActiveID().
     ImGuiInputTextFlags_CharsScientific     = 1 << 17,  // Allow 0123456789.+-*/eE (Scientific notation input)
     ImGuiInputTextFlags_CallbackResize      = 1 << 18,  // Callback on buffer capacity changes request (beyond 'buf_size' parameter value), allowing the string to grow. Notify when the string wants to be resized (for string types which hold a cache of their Size). You will be provided a new BufSize in the callback and NEED to honor it. (see misc/cpp/imgui_stdlib.h for an example of using this)
+    ImGuiInputTextFlags_ApplyOnEditOnly     = 1 << 19,  // Only copy the text back to your buffer on frames where it was edited (or Enter was pressed), instead of whenever your buffer differs from it. Saves a compare per frame, and lets you recreate your buffer every frame (e.g. a temporary std::string) without it being resized and copied into every frame.
     // [Internal]
     ImGuiInputTextFlags_Multiline           = 1 << 20,  // For internal use by InputTextMultiline()
     ImGuiInputTextFlags_NoMarkEdited        = 1 << 21   // For internal use by functions using InputText() before reformatting data
@@ -842,6 +865,15 @@ enum ImGuiSelectableFlags_
     ImGuiSelectableFlags_AllowItemOverlap   = 1 << 4    // (WIP) Hit testing to allow subsequent widgets to overlap this one
 };
 
+// Flags for ImGui::PlotLines(), ImGui::PlotHistogram()
+enum ImGuiPlotFlags_
+{
+    ImGuiPlotFlags_None                     = 0,
+    ImGuiPlotFlags_Decimate                 = 1 << 0,   // Reduce values to a min/max envelope per pixel column, so spikes are never dropped. Rendered as a single polyline/batch of rectangles. Use for large data sets.
+    ImGuiPlotFlags_DecimateLTTB             = 1 << 1,   // Reduce values with Largest-Triangle-Three-Buckets, keeping one point per pixel column which preserves the visual shape. PlotLines() only (PlotHistogram() uses ImGuiPlotFlags_Decimate).
+    ImGuiPlotFlags_StaticData               = 1 << 2    // With decimation: values don't change as long as the same data pointer, count and offset are passed, so the decimated data is reused across frames.
+};
+
 // Flags for ImGui::BeginCombo()
 enum ImGuiComboFlags_
 {
@@ -948,6 +980,14 @@ enum ImGuiDataType_
     ImGuiDataType_COUNT
 };
 
+// Type of the values of an ImGuiDataTable column
+enum ImGuiDataTableColumnType_
+{
+    ImGuiDataTableColumnType_Int,
+    ImGuiDataTableColumnType_Float,
+    ImGuiDataTableColumnType_String
+};
+
 // A cardinal direction
 enum ImGuiDir_
 {
@@ -1234,6 +1274,29 @@ enum ImGuiCond_
     ImGuiCond_Appearing     = 1 << 3    // Set the variable if the object/window is appearing after being hidden/inactive (or the first time)
 };
 
+// Levels for CompactMemory(), each level also does what the previous ones do.
+enum ImGuiCompactLevel_
+{
+    ImGuiCompactLevel_Low,              // Release buffers of windows, tab bars and plots which were not visible last frame, shrink draw lists which grew well above their recent usage
+    ImGuiCompactLevel_Medium,           // Shrink all draw lists, draw channels, columns and tab bars to their current usage, release decimated plot data, release inactive InputText state, frame scratch memory and font atlas RGBA32 pixels (converted again on demand)
+    ImGuiCompactLevel_High              // Release all window buffers and undo history. When called outside of a frame this invalidates the ImDrawData of the last frame: render it first!
+};
+
+// Subsystems allocations are accounted to, when IMGUI_ENABLE_MEMORY_TAGS is defined in imconfig.h.
+enum ImGuiMemTag_
+{
+    ImGuiMemTag_Other,          // Anything not listed below, including your own calls to MemAlloc()
+    ImGuiMemTag_DrawList,       // ImDrawList buffers and draw data
+    ImGuiMemTag_Window,         // Windows and their temporary data (stacks, child lists..)
+    ImGuiMemTag_Storage,        // ImGuiStorage contents (tree nodes open state, etc.)
+    ImGuiMemTag_Font,           // Font atlas, fonts, glyphs and texture data
+    ImGuiMemTag_InputText,      // Text edit buffers, undo history
+    ImGuiMemTag_Settings,       // .ini settings and their serialization
+    ImGuiMemTag_Columns,        // Columns state
+    ImGuiMemTag_TabBar,         // Tab bars state
+    ImGuiMemTag_COUNT
+};
+
 //-----------------------------------------------------------------------------
 // Helpers: Memory allocations macros
 // IM_MALLOC(), IM_FREE(), IM_NEW(), IM_PLACEMENT_NEW(), IM_DELETE()
@@ -1387,6 +1450,9 @@ struct ImGuiIO
     float       DeltaTime;                      // = 1.0f/60.0f     // Time elapsed since last frame, in seconds.
     float       IniSavingRate;                  // = 5.0f           // Minimum time between saving positions/sizes to .ini file, in seconds.
     const char* IniFilename;                    // = "imgui.ini"    // Path to .ini file. Set NULL to disable automatic .ini loading/saving, if e.g. you want to manually load/save from memory.
+    bool        IniSaveBinary;                  // = false          // Save .ini file in a compact binary format instead of text. Loading detects the format.
+    ImGuiRunAsyncFunc IniSaveAsync;             // = NULL           // Optional: write the .ini file away from the main thread, e.g. on your thread pool or job system. Must eventually call task_func(task_data) once, from any thread (may be deferred, even past shutdown: a task still pending when a save must complete is run inline and task_func then only frees it). Settings are serialized beforehand, task_func only uses the file functions.
+    void*       IniSaveAsyncUserData;           // = NULL           // Passed as 'user_data' to IniSaveAsync.
     const char* LogFilename;                    // = "imgui_log.txt"// Path to .log file (default parameter to ImGui::LogToFile when no file is specified).
     float       MouseDoubleClickTime;           // = 0.30f          // Time for a double-click, in seconds.
     float       MouseDoubleClickMaxDist;        // = 6.0f           // Distance threshold to stay in to validate a double-click, in pixels.
@@ -1406,6 +1472,8 @@ struct ImGuiIO
     bool        MouseDrawCursor;                // = false          // Request ImGui to draw a mouse cursor for you (if you are on a platform without a mouse cursor). Cannot be easily renamed to 'io.ConfigXXX' because this is frequently used by back-end implementations.
     bool        ConfigMacOSXBehaviors;          // = defined(__APPLE__) // OS X style: Text editing cursor movement using Alt instead of Ctrl, Shortcuts using Cmd/Super instead of Ctrl, Line/Text Start and End using Cmd+Arrows instead of Home/End, Double click selects by word instead of selecting whole text, Multi-selection in lists uses Cmd/Super instead of Ctrl (was called io.OptMacOSXBehaviors prior to 1.63)
     bool        ConfigInputTextCursorBlink;     // = true           // Set to false to disable blinking cursor, for users who consider it distracting. (was called: io.OptCursorBlink prior to 1.63)
+    int         ConfigInputTextUndoMemoryBudget;// = 256*1024       // Maximum memory in bytes used by the undo/redo history of the active text input. Oldest edits are discarded first. Set to 0 to disable undo/redo.
+    bool        ConfigInputTextUndoCompress;    // = true           // Compress large spans of text stored in the undo/redo history (e.g. deleted selections, replaced text), so more history fits in the budget.
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // [BETA] Set to true to only allow moving windows when clicked+dragged from the title bar. Windows without a title bar are not affected.
     float       ConfigWindowsMemoryCompactTimer;// = 60.0f          // [BETA] Compact window memory usage when unused. Set to -1.0f to disable.
@@ -1577,6 +1645,20 @@ struct ImGuiPayload
     bool IsDelivery() const                 { return Delivery; }
 };
 
+// Memory usage of a subsystem: GetMemTagStats()
+// Only tracked when IMGUI_ENABLE_MEMORY_TAGS is defined in imconfig.h. Values are global to all contexts.
+struct ImGuiMemTagStats
+{
+    size_t          Bytes;              // Memory currently allocated
+    size_t          PeakBytes;          // Highest value reached by Bytes
+    int             Allocs;             // Number of live allocations
+    int             FrameAllocs;        // Number of allocations made during the last frame (between the two last calls to NewFrame()). Should be 0 in steady state.
+    int             TotalAllocs;        // Number of allocations made since startup
+
+    // [Internal]
+    int             CurrFrameAllocs;    // Number of allocations made since the last call to NewFrame()
+};
+
 //-----------------------------------------------------------------------------
 // Obsolete functions (Will be removed! Read 'API BREAKING CHANGES' section in imgui.cpp for details)
 // Please keep your copy of dear imgui up to date! Occasionally set '#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS' in imconfig.h to stay ahead.
@@ -1625,6 +1707,9 @@ struct ImGuiOnceUponAFrame
 };
 
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
+// Build() compiles all the terms into a single case-insensitive matcher, so PassFilter() reads the text once whatever the number of terms.
+// PassFilterLines() filters a whole array of lines and keeps the result: on following calls only the lines added since are filtered, until Build() is called.
+// (The result is stored in the filter, so use one ImGuiTextFilter per array of lines. Call Build() after replacing, clearing or removing lines to filter them all again.)
 struct ImGuiTextFilter
 {
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
@@ -1633,6 +1718,8 @@ struct ImGuiTextFilter
     IMGUI_API void      Build();
     void                Clear()          { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
+    IMGUI_API const ImVector<int>& PassFilterLines(const char* buf, const char* buf_end, const int* line_offsets, int lines_count);   // Return indices of the lines passing the filter. Line n is [buf + line_offsets[n], buf + line_offsets[n + 1] - 1), the last one ends at buf_end. Incremental: call Build() after replacing or clearing the lines!
+    IMGUI_API const ImVector<int>& PassFilterLines(const char* const* lines, int lines_count);                                       // Return indices of the lines passing the filter, from an array of zero-terminated strings. Incremental: call Build() after replacing or clearing the lines!
 
     // [Internal]
     struct ImGuiTextRange
@@ -1648,6 +1735,15 @@ struct ImGuiTextFilter
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+    unsigned char           MatchClass[256];        // Case-folded character class of each byte, 0 for bytes not used by any term
+    int                     MatchClassesCount;
+    int                     MatchStartClassesCount; // Classes [1, MatchStartClassesCount) are the ones of the first character of a term
+    ImVector<ImU16>         MatchNext;              // Matcher transitions: MatchNext[state * MatchClassesCount + class]
+    ImVector<short>         MatchTerm;              // Lowest index into Filters[] of a term ending at each state, or -1
+    int                     MatchFirstTerm;         // Lowest index of all terms, to stop reading the text when found
+    ImVector<int>           LinesPassed;            // Result of PassFilterLines()
+    int                     LinesFiltered;          // Number of lines LinesPassed was computed for
+    const void*             LinesSource;            // 'buf' or 'lines' of the last PassFilterLines() call, another one filters all lines again
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -1671,6 +1767,27 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Text buffer with random access to its lines, a filter and a clipped display (e.g. for a log window, see ExampleAppLog in imgui_demo.cpp)
+// The lines passing the filter are kept (see ImGuiTextFilter::PassFilterLines()): each frame only the lines appended since are filtered, and all lines are filtered again when the filter is edited.
+struct ImGuiTextLog
+{
+    ImGuiTextBuffer     Buf;
+    ImVector<int>       LineOffsets;        // Offset in Buf of the start of each line
+    ImGuiTextFilter     Filter;
+    bool                AutoScroll;         // Keep scrolling to the bottom as lines are appended, if already at the bottom
+
+    IMGUI_API ImGuiTextLog();
+    IMGUI_API void      Clear();
+    IMGUI_API void      Append(const char* text, const char* text_end = NULL);
+    IMGUI_API void      AppendF(const char* fmt, ...) IM_FMTARGS(2);
+    IMGUI_API void      AppendFV(const char* fmt, va_list args) IM_FMTLIST(2);
+    int                 GetLinesCount() const   { return LineOffsets.Size; }
+    const char*         GetLineBegin(int line_no) const { return Buf.begin() + LineOffsets[line_no]; }
+    const char*         GetLineEnd(int line_no) const   { return (line_no + 1 < LineOffsets.Size) ? Buf.begin() + LineOffsets[line_no + 1] - 1 : Buf.end(); }
+    bool                DrawFilter(const char* label = "Filter (inc,-exc)", float width = 0.0f) { return Filter.Draw(label, width); }
+    IMGUI_API void      Draw(const char* str_id, const ImVec2& size = ImVec2(0, 0));     // Child window displaying the lines passing the filter
+};
+
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
@@ -1756,6 +1873,185 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Helper: Manually clip large list of items of varying heights (e.g. wrapped or multi-line text).
+// Item heights are measured as items are displayed and cached in a state identified by 'str_id' within the current window, unknown heights
+// are estimated from the average of the measured ones. When the content width changes, heights are measured again.
+// When items above the visible ones turn out to have a different height than estimated, the window scrolls by the difference so the visible items don't jump.
+// Usage:
+//     ImGuiListClipperVariable clipper("##log", lines_count);
+//     while (clipper.Step())
+//         for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//             ImGui::TextWrapped("%s", lines[i]);
+// - Each Step() returns one item, whose height is measured on the next call, until the bottom of the visible area is reached.
+// - If an item changes height, it is measured again when displayed. Items removed from the end of the list are handled by passing a smaller count.
+struct ImGuiListClipperVariable
+{
+    int     DisplayStart, DisplayEnd;
+    int     ItemsCount;
+
+    // [Internal]
+    int     StepNo;
+    int     StateIdx;
+    float   StartPosY;
+    float   ItemPosY;
+    float   ClipMaxY;
+    int     AnchorIdx;
+    float   AnchorOffset;
+
+    // items_height: Estimate used before any item is measured. Use -1.0f for GetTextLineHeightWithSpacing().
+    IMGUI_API ImGuiListClipperVariable(const char* str_id, int items_count, float items_height = -1.0f);
+    ~ImGuiListClipperVariable()         { IM_ASSERT(ItemsCount == -1); }      // Assert if user forgot to call End() or Step() until false.
+
+    IMGUI_API bool Step();              // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
+    IMGUI_API void End();               // Automatically called on the last call of Step() that returns false.
+};
+
+// Helper: Manually clip a large tree of nodes, only submitting the visible rows.
+// The tree is described in depth-first order by a getter giving the number of nodes in the subtree of a node (excluding itself, 0 for a leaf),
+// and optionally a stable identifier for the node (defaults to its index). Closed subtrees are skipped without querying their nodes.
+// Open states are kept in the window ImGuiStorage like regular tree nodes, so SetNextItemOpen() and GetStateStorage() work the same.
+// The flattened list of visible rows is cached in a state identified by 'str_id' within the current window. It is rebuilt when the number
+// of nodes changes or when a displayed node is opened/closed. Call Invalidate() after other changes to the tree or to the open state of hidden nodes.
+// Usage:
+//     ImGuiTreeClipper clipper("##scene", nodes_count, GetSceneNode, &scene);
+//     while (clipper.Step())
+//         for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+//             clipper.TreeNode(row, scene.Nodes[clipper.GetNodeIdx(row)].Name);
+// - All rows need to have the same height (items_height). Rows are indented by their depth, and don't need TreePop().
+// - Keyboard navigation works across clipped rows. ImGuiTreeNodeFlags_NavLeftJumpsBackHere is only supported through the 'flags' of the constructor,
+//   as the parent of the focused row may be clipped.
+struct ImGuiTreeClipper
+{
+    int     DisplayStart, DisplayEnd;       // Range of rows to display
+    int     RowsCount;                      // Number of visible rows (nodes whose parents are all open), valid after the first Step()
+
+    // [Internal]
+    ImGuiListClipper        ListClipper;
+    ImGuiTreeClipperGetter  Getter;
+    void*                   UserData;
+    int                     NodesCount;
+    int                     StateIdx;
+    ImGuiTreeNodeFlags      Flags;
+    float                   ItemsHeight;
+    int                     NavRow;         // Displayed row holding the navigation focus
+
+    // flags:        Flags applied to all nodes.
+    // items_height: Height of a row. Use -1.0f for GetTextLineHeightWithSpacing() (regular tree nodes), GetFrameHeightWithSpacing() for framed ones.
+    IMGUI_API ImGuiTreeClipper(const char* str_id, int nodes_count, ImGuiTreeClipperGetter getter, void* user_data, ImGuiTreeNodeFlags flags = 0, float items_height = -1.0f);
+
+    IMGUI_API bool      Step();                                                     // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those rows.
+    IMGUI_API void      End();                                                      // Automatically called on the last call of Step() that returns false.
+    IMGUI_API void      Invalidate();                                               // Rebuild the visible rows on next Step().
+    IMGUI_API bool      TreeNode(int row, const char* label, ImGuiTreeNodeFlags flags = 0);  // Submit the node on 'row', return true when open. 'flags' are added to the constructor ones.
+    IMGUI_API int       GetNodeIdx(int row) const;                                  // Index of the node displayed on 'row'
+    IMGUI_API int       GetDepth(int row) const;
+    IMGUI_API ImGuiID   GetID(int row) const;                                       // Item identifier of the node displayed on 'row', also used as key in the state storage
+};
+
+// Helper: Fixed-capacity history of values for PlotLinesStream()/PlotHistogramStream(), e.g. real-time telemetry.
+// - Push() may be called from one other thread (lock-free single producer/single consumer queue). Values are moved to the history by Update(),
+//   which the Plot***Stream() functions call. If nothing calls Update() (e.g. the plot is not visible), Push() drops values once the queue is full.
+// - The history keeps min/max aggregates in a segment tree, so GetMinMax() over any range is O(log N) and auto-scaling doesn't rescan the values.
+// Usage:
+//     static ImGuiPlotStream stream(10000);   // Keep the last 10000 values
+//     stream.Push(value);                     // From your sampling thread (or anywhere)
+//     ImGui::PlotLinesStream("Signal", &stream);
+struct ImGuiPlotStream
+{
+    // Queue, shared with the producer
+    ImVector<float>     Queue;
+    volatile long       QueueHead;              // Written by the consumer (Update)
+    volatile long       QueueTail;              // Written by the producer (Push)
+    volatile long       DroppedCount;           // Values dropped by Push() because the queue was full
+
+    // History, owned by the consumer
+    int                 Capacity;
+    ImS64               Count;                  // Number of values ever moved to the history. The oldest one still present is Count - GetSize().
+    ImVector<float>     Values;                 // Ring buffer of Capacity values, the value number N is at Values[N % Capacity]
+    ImVector<ImVec2>    Tree;                   // Segment tree of (min, max) over Values[], NaN ignored. Leaves start at Tree[TreeLeaves].
+    int                 TreeLeaves;
+    int                 ClearCount;             // Incremented by Clear(), so plots can tell a refilled history from one which only grew
+
+    // queue_capacity: Use 0 to size the queue after the capacity, rounded up to a power of two.
+    IMGUI_API ImGuiPlotStream(int capacity, int queue_capacity = 0);
+    IMGUI_API bool      Push(float v);                                              // Thread-safe for a single producer. Return false if the value was dropped.
+    IMGUI_API void      Update();                                                   // Move pushed values to the history. Call from the thread which owns the stream (the one calling Plot***Stream()).
+    IMGUI_API void      Clear();                                                    // Clear the history, not the queue. Consumer thread only.
+    IMGUI_API void      GetMinMax(int first, int count, float* out_min, float* out_max) const;    // Min/max of values [first, first+count) of the history, FLT_MAX/-FLT_MAX if none.
+    int                 GetSize() const         { return (int)(Count < Capacity ? Count : Capacity); }
+    float               operator[](int i) const { IM_ASSERT(i >= 0 && i < GetSize()); return Values[(int)((Count - GetSize() + i) % Capacity)]; }   // 0 is the oldest value of the history
+};
+
+// Helper: Table of typed columns of values (int, float or string), displayed with a header row which sorts the table and resizes its columns.
+// - Values are stored per column in contiguous arrays. Rows are displayed through ImGuiListClipper, so a frame only costs the visible cells.
+// - Clicking a header sorts by its column, clicking it again reverses the order. Shift+Click adds a secondary key (or reverses it).
+//   The display order is cached in SortedRows and only computed again after values or sort keys changed.
+// - With SortAsync set, the sort runs on a copy of the keys away from the main thread. The previous order is displayed until it completes.
+// - Column widths are saved in the .ini file, identified by 'str_id' within the current window.
+// Usage:
+//     static ImGuiDataTable table;
+//     if (table.Columns.empty())
+//     {
+//         table.AddColumn("Name", ImGuiDataTableColumnType_String);
+//         table.AddColumn("Size", ImGuiDataTableColumnType_Int, "%d bytes");
+//     }
+//     int row = table.AddRow();
+//     table.SetString(row, 0, "readme.txt");
+//     table.SetInt(row, 1, 1024);
+//     table.Draw("##files");
+struct ImGuiDataTableColumn
+{
+    char*                       Label;
+    char*                       Format;         // printf format of Int and Float values
+    ImGuiDataTableColumnType    Type;
+    ImVector<int>               Ints;           // Values of an Int column
+    ImVector<float>             Floats;         // Values of a Float column
+    ImVector<int>               StringOffsets;  // Offset in StringsBuf of the zero-terminated value of each row, for a String column
+    ImVector<char>              StringsBuf;     // Setting a string value overwrites the previous one if it fits, otherwise appends it
+    int                         StringsBufDead; // Bytes of StringsBuf no longer referenced by any row. StringsBuf is compacted once they outweigh the live bytes.
+
+    ImGuiDataTableColumn()      { Label = Format = NULL; Type = ImGuiDataTableColumnType_Int; StringsBufDead = 0; }
+    ~ImGuiDataTableColumn()     { if (Label) IM_FREE(Label); if (Format) IM_FREE(Format); }
+};
+
+struct ImGuiDataTableSortSpec
+{
+    int         ColumnIndex;
+    bool        Descending;
+};
+
+struct ImGuiDataTable
+{
+    ImVector<ImGuiDataTableColumn>      Columns;
+    int                                 RowsCount;
+    ImVector<ImGuiDataTableSortSpec>    SortSpecs;          // Sort keys, most significant first. Empty to display the rows in the order they were added.
+    ImVector<int>                       SortedRows;         // Row displayed at each position. Rows added since the last sort completed are displayed after those, in the order they were added.
+    ImGuiRunAsyncFunc                   SortAsync;          // = NULL   // Optional: sort away from the main thread, e.g. on your thread pool or job system. Must eventually call task_func(task_data) once, from any thread (may be deferred: a sort still pending when Sort(true) or the destructor needs it is run inline or dropped, task_func then only frees it).
+    void*                               SortAsyncUserData;  // = NULL   // Passed as 'user_data' to SortAsync.
+
+    // [Internal]
+    int                                 Version;            // Incremented when values or sort keys are modified
+    int                                 SortedVersion;      // Version SortedRows was computed for
+    void*                               SortTask;           // Asynchronous sort in flight, NULL if none
+
+    IMGUI_API ImGuiDataTable();
+    IMGUI_API ~ImGuiDataTable();
+    IMGUI_API void      Clear();                                                    // Remove all columns and rows
+    IMGUI_API void      ClearRows();
+    IMGUI_API int       AddColumn(const char* label, ImGuiDataTableColumnType type, const char* format = NULL);    // Return the column index. Default format is "%d" or "%.3f". Add columns before rows.
+    IMGUI_API int       AddRow();                                                   // Append a row of zero/empty values, return its index
+    IMGUI_API void      SetInt(int row, int column, int v);
+    IMGUI_API void      SetFloat(int row, int column, float v);
+    IMGUI_API void      SetString(int row, int column, const char* s, const char* s_end = NULL);
+    int                 GetInt(int row, int column) const           { IM_ASSERT(Columns[column].Type == ImGuiDataTableColumnType_Int); return Columns[column].Ints[row]; }
+    float               GetFloat(int row, int column) const         { IM_ASSERT(Columns[column].Type == ImGuiDataTableColumnType_Float); return Columns[column].Floats[row]; }
+    const char*         GetString(int row, int column) const        { IM_ASSERT(Columns[column].Type == ImGuiDataTableColumnType_String); return Columns[column].StringsBuf.Data + Columns[column].StringOffsets[row]; }
+    int                 GetRowAt(int display_pos) const             { return display_pos < SortedRows.Size ? SortedRows[display_pos] : display_pos; }
+    IMGUI_API void      SortBy(int column, bool descending, bool add_key = false);  // Sort by a single key, or add a least significant key (only changing its order if already present)
+    IMGUI_API bool      Sort(bool wait = false);                                    // Update SortedRows if needed (called by Draw). Return false while an asynchronous sort is in flight, unless 'wait' is set.
+    IMGUI_API void      Draw(const char* str_id, const ImVec2& size = ImVec2(0, 0)); // Child window displaying the header and the visible rows
+};
+
 // Helpers macros to generate 32-bit encoded colors
 #ifdef IMGUI_USE_BGRA_PACKED_COLOR
 #define IM_COL32_R_SHIFT    16
@@ -2060,6 +2356,8 @@ struct ImFontConfig
     unsigned int    RasterizerFlags;        // 0x00     // Settings for custom font rasterizer (e.g. ImGuiFreeType). Leave as zero if you aren't using one.
     float           RasterizerMultiply;     // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable.
     ImWchar         EllipsisChar;           // -1       // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
+    bool            SignedDistanceField;    // false    // Rasterize glyphs as 8-bit signed distance fields (edge at value 128) instead of coverage, so a single size can be rendered sharply at any scale. Requires a dedicated shader, see docs/FONTS.txt. Oversampling and RasterizerMultiply are ignored. Not supported by ImGuiFreeType.
+    float           SignedDistanceFieldSpread; // 4.0f  // Distance in pixels (at SizePixels) covered by the distance falloff on each side of the glyph edges. This is also the padding added around each glyph.
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -2109,7 +2407,8 @@ enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
-    ImFontAtlasFlags_NoMouseCursors     = 1 << 1    // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_TightPacking       = 1 << 2    // Pack glyphs of all fonts together with a best-fit heuristic, and try every power-of-two width to keep the smallest texture (unless TexDesiredWidth is set). Slower to build.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2153,8 +2452,21 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 1 byte per-pixel
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     bool                        IsBuilt() const             { return Fonts.Size > 0 && (TexPixelsAlpha8 != NULL || TexPixelsRGBA32 != NULL); }
+    IMGUI_API float             CalcTexOccupancy() const;   // Ratio of the texture surface used by glyphs and custom rectangles (0.0f..1.0f). Use ImFontAtlasFlags_TightPacking/ImFontAtlasFlags_NoPowerOfTwoHeight to increase it.
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Prebuilt atlas cache.
+    // Save the output of Build() (texture pixels, glyphs, custom rectangles) in a versioned binary blob, along with a hash of all inputs.
+    // On the next run, add the same fonts and call LoadFromMemory()/LoadFromFile() instead of Build(): they return false if the blob
+    // is missing, corrupted or was built from different inputs, in which case you can call Build() and save again.
+    // With copy_data=false, texture pixels are used in place (e.g. from a memory-mapped file): 'data' must stay valid and unmodified while the atlas uses it.
+    // Note that the inputs hash doesn't know which rasterizer produced the data (stb_truetype or FreeType): use separate files if you switch.
+    IMGUI_API bool              SaveToMemory(ImVector<unsigned char>* out_data) const;
+    IMGUI_API bool              LoadFromMemory(const void* data, size_t data_size, bool copy_data = true);
+    IMGUI_API bool              SaveToFile(const char* filename) const;
+    IMGUI_API bool              LoadFromFile(const char* filename);
+    IMGUI_API ImU32             CalcInputsHash() const;     // Hash of all inputs used by Build(): font data and configuration, custom rectangles, atlas flags and settings.
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -2197,11 +2509,14 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    ImFontAtlasParallelForFunc  BuildParallelFor;   // = NULL   // Optional: run the glyph rasterization tasks of Build() concurrently, e.g. on your thread pool or job system. Must call task_func(task_data, n) for every n in [0,tasks_count) and return once all of them completed. Output is identical to the serial build.
+    void*                       BuildParallelForUserData; // = NULL // Passed as 'user_data' to BuildParallelFor.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
+    bool                        TexPixelsAlpha8External; // TexPixelsAlpha8 points to memory owned by the user, see LoadFromMemory() with copy_data=false.
     int                         TexWidth;           // Texture width calculated during Build().
     int                         TexHeight;          // Texture height calculated during Build().
     ImVec2                      TexUvScale;         // = (1.0f/TexWidth, 1.0f/TexHeight)
@@ -2217,17 +2532,23 @@ struct ImFontAtlas
 #endif
 };
 
+// Glyph lookup tables of ImFont are split in pages of IM_FONT_INDEX_PAGE_SIZE code points, only allocated for ranges which have glyphs.
+// A font with a few glyphs far in the Unicode range (e.g. some icons merged at 0xF000) doesn't pay for a dense table up to its largest code point.
+#define IM_FONT_INDEX_PAGE_SHIFT    8
+#define IM_FONT_INDEX_PAGE_SIZE     (1 << IM_FONT_INDEX_PAGE_SHIFT)
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
 {
-    // Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this this info, and are often bottleneck in large UI).
+    // Members: Hot ~32/40 bytes (for CalcTextSize)
+    ImVector<ImU16>             IndexPageMap;       // 12-16 // out //            // Page index in IndexAdvanceX/IndexLookup for each block of IM_FONT_INDEX_PAGE_SIZE code points. Page 0 is shared by all blocks without glyphs.
+    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Paged. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this this info, and are often bottleneck in large UI).
     float                       FallbackAdvanceX;   // 4     // out // = FallbackGlyph->AdvanceX
     float                       FontSize;           // 4     // in  //            // Height of characters/line, set during loading (don't change after loading)
 
     // Members: Hot ~36/48 bytes (for CalcTextSize + render loop)
-    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Sparse. Index glyphs by Unicode code-point.
+    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Paged. Index glyphs by Unicode code-point.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out //            // All glyphs.
     const ImFontGlyph*          FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
     ImVec2                      DisplayOffset;      // 8     // in  // = (0,0)    // Offset font rendering by xx pixels
@@ -2248,8 +2569,9 @@ struct ImFont
     IMGUI_API ~ImFont();
     IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c) const     { int slot = GetIndexSlot(c); return (slot >= 0) ? IndexAdvanceX.Data[slot] : FallbackAdvanceX; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
+    bool                        IsSignedDistanceField() const       { return ConfigData != NULL && ConfigData->SignedDistanceField; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
     // 'max_width' stops rendering after a certain width (could be turned into a 2d size). FLT_MAX to disable.
@@ -2263,6 +2585,8 @@ struct ImFont
     IMGUI_API void              BuildLookupTable();
     IMGUI_API void              ClearOutputData();
     IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API int               AllocIndexSlot(ImWchar c);
+    int                         GetIndexSlot(unsigned int c) const  { unsigned int page = c >> IM_FONT_INDEX_PAGE_SHIFT; return (page < (unsigned int)IndexPageMap.Size) ? ((int)IndexPageMap.Data[page] << IM_FONT_INDEX_PAGE_SHIFT) + (int)(c & (IM_FONT_INDEX_PAGE_SIZE - 1)) : -1; }
     IMGUI_API void              AddGlyph(ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetFallbackChar(ImWchar c);
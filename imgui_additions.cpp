@@ -713,10 +713,8 @@ static int InputTextCallback(ImGuiInputTextCallbackData* data)
     {
         // Resize string callback
         // If for some reason we refuse the new length (BufTextLen) and/or capacity (BufSize) we need to set them back to what we want.
-        std::string* str = user_data->Str;
-        IM_ASSERT(data->Buf == str->c_str());
-        str->resize(data->BufTextLen);
-        data->Buf = (char*)str->c_str();
+        // See ImInputTextResizeString() for the growth policy.
+        ImInputTextResizeString(data, user_data->Str);
     }
     else if (user_data->ChainCallback)
     {
@@ -370,6 +370,8 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::SameLine(); HelpMarker("Instruct back-end to not alter mouse cursor shape and visibility.");
             ImGui::Checkbox("io.ConfigInputTextCursorBlink", &io.ConfigInputTextCursorBlink);
             ImGui::SameLine(); HelpMarker("Set to false to disable blinking cursor, for users who consider it distracting");
+            ImGui::Checkbox("io.ConfigInputTextUndoCompress", &io.ConfigInputTextUndoCompress);
+            ImGui::SameLine(); HelpMarker("Compress large spans of text stored in the undo/redo history of text inputs, so more history fits in io.ConfigInputTextUndoMemoryBudget.");
             ImGui::Checkbox("io.ConfigWindowsResizeFromEdges", &io.ConfigWindowsResizeFromEdges);
             ImGui::SameLine(); HelpMarker("Enable resizing of windows from their edges and from the lower-left corner.\nThis requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback.");
             ImGui::Checkbox("io.ConfigWindowsMoveFromTitleBarOnly", &io.ConfigWindowsMoveFromTitleBarOnly);
@@ -694,6 +696,31 @@ static void ShowDemoWindowWidgets()
                 ImGui::Indent(ImGui::GetTreeNodeToLabelSpacing());
             ImGui::TreePop();
         }
+        if (ImGui::TreeNode("Large tree, clipped"))
+        {
+            HelpMarker("ImGuiTreeClipper only submits the visible rows of a tree described in depth-first order.\nOpen/close nodes with the mouse or the arrow keys, Left arrow on a child jumps back to its parent.");
+
+            // A tree of 111110 nodes (10 roots, 10 children per node, 5 levels deep), stored in depth-first order as the size of each subtree.
+            static ImVector<int> descendants;
+            if (descendants.empty())
+            {
+                struct Funcs { static int Build(ImVector<int>& out, int depth) { int idx = out.Size; out.push_back(0); int count = 0; for (int n = 0; depth < 4 && n < 10; n++) count += 1 + Build(out, depth + 1); out[idx] = count; return count; } };
+                for (int n = 0; n < 10; n++)
+                    Funcs::Build(descendants, 0);
+            }
+            struct Funcs { static void GetNode(void* data, int node_idx, int* out_descendants_count, ImGuiID*) { *out_descendants_count = (*(ImVector<int>*)data)[node_idx]; } };
+            ImGui::BeginChild("##tree", ImVec2(0, ImGui::GetFontSize() * 20.0f), true);
+            ImGuiTreeClipper clipper("##tree", descendants.Size, Funcs::GetNode, &descendants, ImGuiTreeNodeFlags_NavLeftJumpsBackHere);
+            while (clipper.Step())
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    char label[32];
+                    sprintf(label, "Node %d", clipper.GetNodeIdx(row));
+                    clipper.TreeNode(row, label);
+                }
+            ImGui::EndChild();
+            ImGui::TreePop();
+        }
         ImGui::TreePop();
     }
 
@@ -1147,6 +1174,33 @@ static void ShowDemoWindowWidgets()
         ImGui::PlotHistogram("Histogram", func, NULL, display_count, 0, NULL, -1.0f, 1.0f, ImVec2(0,80));
         ImGui::Separator();
 
+        // Large data sets can be decimated to one entry per pixel column.
+        // With point sampling (no flags), the rare spikes of this signal are mostly missed.
+        static float big_values[100000];
+        static bool big_values_init = false;
+        if (!big_values_init)
+        {
+            for (int n = 0; n < IM_ARRAYSIZE(big_values); n++)
+                big_values[n] = sinf(n * 0.0005f) * 0.5f + ((n % 7919) == 0 ? 2.0f : 0.0f);
+            big_values_init = true;
+        }
+        static int decimate_mode = 1;
+        ImGui::RadioButton("No decimation", &decimate_mode, 0); ImGui::SameLine();
+        ImGui::RadioButton("Min/Max", &decimate_mode, 1); ImGui::SameLine();
+        ImGui::RadioButton("LTTB", &decimate_mode, 2);
+        ImGuiPlotFlags plot_flags = (decimate_mode == 1) ? ImGuiPlotFlags_Decimate : (decimate_mode == 2) ? ImGuiPlotFlags_DecimateLTTB : ImGuiPlotFlags_None;
+        plot_flags |= ImGuiPlotFlags_StaticData; // Our values never change
+        ImGui::PlotLines("100k values", big_values, IM_ARRAYSIZE(big_values), 0, NULL, FLT_MAX, FLT_MAX, ImVec2(0,80), sizeof(float), plot_flags);
+
+        // Streams keep the last N values pushed (possibly from another thread) and scroll as values are pushed.
+        static ImGuiPlotStream stream(5000);
+        static int stream_phase = 0;
+        if (animate)
+            for (int n = 0; n < 16; n++, stream_phase++)
+                stream.Push(sinf(stream_phase * 0.01f) + sinf(stream_phase * 0.37f) * 0.2f);
+        ImGui::PlotLinesStream("Stream", &stream, NULL, -1.2f, 1.4f, ImVec2(0,80));
+        ImGui::Separator();
+
         // Animate a simple progress bar
         static float progress = 0.0f, progress_dir = 1.0f;
         if (animate)
@@ -2878,6 +2932,48 @@ static void ShowDemoWindowColumns()
         ImGui::TreePop();
     }
 
+    // Sorting 100000 rows is done with SortAsync. Without threads in this demo, we run the sort at the beginning of the next frame:
+    // the previous order is displayed meanwhile. In your application you would hand the task to your job system.
+    struct DeferredTask
+    {
+        void (*Func)(void* task_data);
+        void* Data;
+        static void Queue(void (*task_func)(void* task_data), void* task_data, void* user_data) { DeferredTask* t = (DeferredTask*)user_data; IM_ASSERT(t->Func == NULL); t->Func = task_func; t->Data = task_data; }
+    };
+    static DeferredTask data_table_sort = { NULL, NULL };
+    if (data_table_sort.Func != NULL)
+    {
+        void (*func)(void*) = data_table_sort.Func;
+        data_table_sort.Func = NULL;
+        func(data_table_sort.Data);
+    }
+
+    if (ImGui::TreeNode("Data table"))
+    {
+        static ImGuiDataTable table;
+        if (table.Columns.empty())
+        {
+            table.SortAsync = DeferredTask::Queue;
+            table.SortAsyncUserData = &data_table_sort;
+            table.AddColumn("ID", ImGuiDataTableColumnType_Int);
+            table.AddColumn("Name", ImGuiDataTableColumnType_String);
+            table.AddColumn("Quantity", ImGuiDataTableColumnType_Int, "x%d");
+            table.AddColumn("Price", ImGuiDataTableColumnType_Float, "%.2f");
+            const char* names[] = { "Apple", "Banana", "Cherry", "Kiwi", "Mango", "Orange", "Pineapple", "Strawberry" };
+            for (int n = 0; n < 100000; n++)
+            {
+                int row = table.AddRow();
+                table.SetInt(row, 0, n);
+                table.SetString(row, 1, names[(n * 7) % IM_ARRAYSIZE(names)]);
+                table.SetInt(row, 2, (n * 37) % 100);
+                table.SetFloat(row, 3, ((n * 13) % 1000) * 0.05f);
+            }
+        }
+        ImGui::Text("%d rows. Click on a header to sort, Shift+Click to add a secondary key.", table.RowsCount);
+        table.Draw("##table", ImVec2(0, ImGui::GetFontSize() * 20));
+        ImGui::TreePop();
+    }
+
     if (ImGui::TreeNode("Tree"))
     {
         ImGui::Columns(2, "tree", true);
@@ -3186,6 +3282,8 @@ void ImGui::ShowAboutWindow(bool* p_open)
         if (io.MouseDrawCursor)                                         ImGui::Text("io.MouseDrawCursor");
         if (io.ConfigMacOSXBehaviors)                                   ImGui::Text("io.ConfigMacOSXBehaviors");
         if (io.ConfigInputTextCursorBlink)                              ImGui::Text("io.ConfigInputTextCursorBlink");
+        ImGui::Text("io.ConfigInputTextUndoMemoryBudget = %d", io.ConfigInputTextUndoMemoryBudget);
+        if (io.ConfigInputTextUndoCompress)                             ImGui::Text("io.ConfigInputTextUndoCompress");
         if (io.ConfigWindowsResizeFromEdges)                            ImGui::Text("io.ConfigWindowsResizeFromEdges");
         if (io.ConfigWindowsMoveFromTitleBarOnly)                       ImGui::Text("io.ConfigWindowsMoveFromTitleBarOnly");
         if (io.ConfigWindowsMemoryCompactTimer >= 0.0f)                 ImGui::Text("io.ConfigWindowsMemoryCompactTimer = %.1ff", io.ConfigWindowsMemoryCompactTimer);
@@ -3432,6 +3530,7 @@ void ImGui::ShowStyleEditor(ImGuiStyle* ref)
                     ImGui::Text("Ellipsis character: '%c' (U+%04X)", font->EllipsisChar, font->EllipsisChar);
                     const float surface_sqrt = sqrtf((float)font->MetricsTotalSurface);
                     ImGui::Text("Texture Area: about %d px ~%dx%d px", font->MetricsTotalSurface, (int)surface_sqrt, (int)surface_sqrt);
+                    ImGui::Text("Lookup tables: %d pages, %d bytes", font->IndexLookup.Size / IM_FONT_INDEX_PAGE_SIZE, font->IndexPageMap.size_in_bytes() + font->IndexAdvanceX.size_in_bytes() + font->IndexLookup.size_in_bytes());
                     for (int config_i = 0; config_i < font->ConfigDataCount; config_i++)
                         if (font->ConfigData)
                             if (const ImFontConfig* cfg = &font->ConfigData[config_i])
@@ -3481,6 +3580,8 @@ void ImGui::ShowStyleEditor(ImGuiStyle* ref)
             }
             if (ImGui::TreeNode("Atlas texture", "Atlas texture (%dx%d pixels)", atlas->TexWidth, atlas->TexHeight))
             {
+                ImGui::Text("Occupancy: %.1f%%", atlas->CalcTexOccupancy() * 100.0f);
+                ImGui::SameLine(); HelpMarker("Ratio of the texture used by glyphs and custom rectangles.\nSet 'io.Fonts->Flags |= ImFontAtlasFlags_TightPacking' before building the atlas to reduce its size.");
                 ImVec4 tint_col = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
                 ImVec4 border_col = ImVec4(1.0f, 1.0f, 1.0f, 0.5f);
                 ImGui::Image(atlas->TexID, ImVec2((float)atlas->TexWidth, (float)atlas->TexHeight), ImVec2(0, 0), ImVec2(1, 1), tint_col, border_col);
@@ -3742,7 +3843,7 @@ struct ExampleAppConsole
         // However, note that you can not use this code as is if a filter is active because it breaks the 'cheap random-access' property. We would need random-access on the post-filtered list.
         // A typical application wanting coarse clipping and filtering may want to pre-compute an array of indices that passed the filtering test, recomputing this array when user changes the filter,
         // and appending newly elements as they are inserted. This is left as a task to the user until we can manage to improve this example code!
-        // If your items are of variable size you may want to implement code similar to what ImGuiListClipper does. Or split your data into fixed height items to allow random-seeking into your list.
+        // If your items are of variable size you may use the ImGuiListClipperVariable helper instead, which measures items as they are displayed. Or split your data into fixed height items to allow random-seeking into your list.
         ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4,1)); // Tighten spacing
         if (copy_to_clipboard)
             ImGui::LogToClipboard();
@@ -3953,36 +4054,20 @@ static void ShowExampleAppConsole(bool* p_open)
 //  static ExampleAppLog my_log;
 //  my_log.AddLog("Hello %d world\n", 123);
 //  my_log.Draw("title");
+// The ImGuiTextLog helper holds the text and an array pointing to the beginning of each line, allowing random access on lines.
+// This is what allows it to only process the lines that are within the visible area with ImGuiListClipper, including when its filter is active.
 struct ExampleAppLog
 {
-    ImGuiTextBuffer     Buf;
-    ImGuiTextFilter     Filter;
-    ImVector<int>       LineOffsets;        // Index to lines offset. We maintain this with AddLog() calls, allowing us to have a random access on lines
-    bool                AutoScroll;     // Keep scrolling if already at the bottom
-
-    ExampleAppLog()
-    {
-        AutoScroll = true;
-        Clear();
-    }
+    ImGuiTextLog        Log;
 
-    void    Clear()
-    {
-        Buf.clear();
-        LineOffsets.clear();
-        LineOffsets.push_back(0);
-    }
+    void    Clear()     { Log.Clear(); }
 
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
     {
-        int old_size = Buf.size();
         va_list args;
         va_start(args, fmt);
-        Buf.appendfv(fmt, args);
+        Log.AppendFV(fmt, args);
         va_end(args);
-        for (int new_size = Buf.size(); old_size < new_size; old_size++)
-            if (Buf[old_size] == '\n')
-                LineOffsets.push_back(old_size + 1);
     }
 
     void    Draw(const char* title, bool* p_open = NULL)
@@ -3996,7 +4081,7 @@ struct ExampleAppLog
         // Options menu
         if (ImGui::BeginPopup("Options"))
         {
-            ImGui::Checkbox("Auto-scroll", &AutoScroll);
+            ImGui::Checkbox("Auto-scroll", &Log.AutoScroll);
             ImGui::EndPopup();
         }
 
@@ -4008,63 +4093,14 @@ struct ExampleAppLog
         ImGui::SameLine();
         bool copy = ImGui::Button("Copy");
         ImGui::SameLine();
-        Filter.Draw("Filter", -100.0f);
+        Log.DrawFilter("Filter", -100.0f);
 
         ImGui::Separator();
-        ImGui::BeginChild("scrolling", ImVec2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
-
         if (clear)
             Clear();
         if (copy)
             ImGui::LogToClipboard();
-
-        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
-        const char* buf = Buf.begin();
-        const char* buf_end = Buf.end();
-        if (Filter.IsActive())
-        {
-            // In this example we don't use the clipper when Filter is enabled.
-            // This is because we don't have a random access on the result on our filter.
-            // A real application processing logs with ten of thousands of entries may want to store the result of search/filter.
-            // especially if the filtering function is not trivial (e.g. reg-exp).
-            for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
-            {
-                const char* line_start = buf + LineOffsets[line_no];
-                const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                if (Filter.PassFilter(line_start, line_end))
-                    ImGui::TextUnformatted(line_start, line_end);
-            }
-        }
-        else
-        {
-            // The simplest and easy way to display the entire buffer:
-            //   ImGui::TextUnformatted(buf_begin, buf_end);
-            // And it'll just work. TextUnformatted() has specialization for large blob of text and will fast-forward to skip non-visible lines.
-            // Here we instead demonstrate using the clipper to only process lines that are within the visible area.
-            // If you have tens of thousands of items and their processing cost is non-negligible, coarse clipping them on your side is recommended.
-            // Using ImGuiListClipper requires A) random access into your data, and B) items all being the  same height,
-            // both of which we can handle since we an array pointing to the beginning of each line of text.
-            // When using the filter (in the block of code above) we don't have random access into the data to display anymore, which is why we don't use the clipper.
-            // Storing or skimming through the search result would make it possible (and would be recommended if you want to search through tens of thousands of entries)
-            ImGuiListClipper clipper;
-            clipper.Begin(LineOffsets.Size);
-            while (clipper.Step())
-            {
-                for (int line_no = clipper.DisplayStart; line_no < clipper.DisplayEnd; line_no++)
-                {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                    ImGui::TextUnformatted(line_start, line_end);
-                }
-            }
-            clipper.End();
-        }
-        ImGui::PopStyleVar();
-
-        if (AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
-            ImGui::SetScrollHereY(1.0f);
-
-        ImGui::EndChild();
+        Log.Draw("scrolling");
         ImGui::End();
     }
 };
@@ -4248,7 +4284,7 @@ static void ShowExampleAppLongText(bool* p_open)
     static ImGuiTextBuffer log;
     static int lines = 0;
     ImGui::Text("Printing unusually long amount of text.");
-    ImGui::Combo("Test type", &test_type, "Single call to TextUnformatted()\0Multiple calls to Text(), clipped\0Multiple calls to Text(), not clipped (slow)\0");
+    ImGui::Combo("Test type", &test_type, "Single call to TextUnformatted()\0Multiple calls to Text(), clipped\0Multiple calls to Text(), not clipped (slow)\0Multiple calls to TextWrapped(), clipped\0");
     ImGui::Text("Buffer contents: %d lines, %d bytes", lines, log.size());
     if (ImGui::Button("Clear")) { log.clear(); lines = 0; }
     ImGui::SameLine();
@@ -4283,6 +4319,17 @@ static void ShowExampleAppLongText(bool* p_open)
             ImGui::Text("%i The quick brown fox jumps over the lazy dog", i);
         ImGui::PopStyleVar();
         break;
+    case 3:
+        {
+            // Multiple calls to TextWrapped(), manually clipped - demonstrate how to use the ImGuiListClipperVariable helper for items of varying heights.
+            // Resize the window to see line heights change: they are measured again, and the visible lines stay in place.
+            const char* text = "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog.";
+            ImGuiListClipperVariable clipper("##lines", lines);
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                    ImGui::TextWrapped("%i %.*s", i, (i % 4 + 1) * 45 - 1, text);
+            break;
+        }
     }
     ImGui::EndChild();
     ImGui::End();
@@ -422,6 +422,7 @@ ImDrawList* ImDrawList::CloneOutput() const
 
 void ImDrawList::AddDrawCmd()
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = GetCurrentClipRect();
     draw_cmd.TextureId = GetCurrentTextureId();
@@ -492,6 +493,7 @@ void ImDrawList::UpdateTextureID()
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_current_clip_rect)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect && _ClipRectStack.Size)
     {
@@ -522,6 +524,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     _TextureIdStack.push_back(texture_id);
     UpdateTextureID();
 }
@@ -538,6 +541,7 @@ void ImDrawList::PopTextureID()
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     // Large mesh support (when enabled)
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
@@ -1309,6 +1313,7 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -1347,6 +1352,7 @@ static inline bool CanMergeDrawCommands(ImDrawCmd* a, ImDrawCmd* b)
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_DrawList);
     // Note that we never use or rely on channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_Count <= 1)
         return;
@@ -1523,6 +1529,8 @@ ImFontConfig::ImFontConfig()
     RasterizerFlags = 0x00;
     RasterizerMultiply = 1.0f;
     EllipsisChar = (ImWchar)-1;
+    SignedDistanceField = false;
+    SignedDistanceFieldSpread = 4.0f;
     memset(Name, 0, sizeof(Name));
     DstFont = NULL;
 }
@@ -1587,9 +1595,12 @@ ImFontAtlas::ImFontAtlas()
     TexID = (ImTextureID)NULL;
     TexDesiredWidth = 0;
     TexGlyphPadding = 1;
+    BuildParallelFor = NULL;
+    BuildParallelForUserData = NULL;
 
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
+    TexPixelsAlpha8External = false;
     TexWidth = TexHeight = 0;
     TexUvScale = ImVec2(0.0f, 0.0f);
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
@@ -1629,12 +1640,13 @@ void    ImFontAtlas::ClearInputData()
 void    ImFontAtlas::ClearTexData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
-    if (TexPixelsAlpha8)
+    if (TexPixelsAlpha8 && !TexPixelsAlpha8External)
         IM_FREE(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
         IM_FREE(TexPixelsRGBA32);
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
+    TexPixelsAlpha8External = false;
 }
 
 void    ImFontAtlas::ClearFonts()
@@ -1654,6 +1666,7 @@ void    ImFontAtlas::Clear()
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     // Build atlas on demand
     if (TexPixelsAlpha8 == NULL)
     {
@@ -1670,6 +1683,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -1694,6 +1708,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
@@ -1818,8 +1833,17 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
     return font;
 }
 
+// Size of the default rectangle holding the mouse cursors and the white pixel, see ImFontAtlasBuildRegisterDefaultCustomRects()
+static void ImFontAtlasBuildGetDefaultCustomRectSize(const ImFontAtlas* atlas, unsigned short* out_width, unsigned short* out_height)
+{
+    const bool mouse_cursors = !(atlas->Flags & ImFontAtlasFlags_NoMouseCursors);
+    *out_width = (unsigned short)(mouse_cursors ? FONT_ATLAS_DEFAULT_TEX_DATA_W_HALF * 2 + 1 : 2);
+    *out_height = (unsigned short)(mouse_cursors ? FONT_ATLAS_DEFAULT_TEX_DATA_H : 2);
+}
+
 int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     // Breaking change on 2019/11/21 (1.74): ImFontAtlas::AddCustomRectRegular() now requires an ID >= 0x110000 (instead of >= 0x10000)
     IM_ASSERT(id >= 0x110000);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
@@ -1834,6 +1858,7 @@ int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     IM_ASSERT(font != NULL);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
@@ -1880,10 +1905,309 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     return ImFontAtlasBuildWithStbTruetype(this);
 }
 
+// Glyphs created from custom rectangles (AddCustomRectFontGlyph) are counted once, through their glyph.
+// Padding between rectangles isn't counted as used.
+float   ImFontAtlas::CalcTexOccupancy() const
+{
+    if (TexWidth <= 0 || TexHeight <= 0)
+        return 0.0f;
+    float used_surface = 0.0f;
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        const ImFont* font = Fonts[font_i];
+        for (int glyph_i = 0; glyph_i < font->Glyphs.Size; glyph_i++)
+        {
+            const ImFontGlyph& glyph = font->Glyphs[glyph_i];
+            if (glyph.Codepoint != '\t') // Copy of ' ' created by BuildLookupTable()
+                used_surface += IM_ROUND((glyph.U1 - glyph.U0) * TexWidth) * IM_ROUND((glyph.V1 - glyph.V0) * TexHeight);
+        }
+    }
+    for (int rect_i = 0; rect_i < CustomRects.Size; rect_i++)
+        if (CustomRects[rect_i].Font == NULL && CustomRects[rect_i].IsPacked())
+            used_surface += (float)CustomRects[rect_i].Width * CustomRects[rect_i].Height;
+    return used_surface / ((float)TexWidth * TexHeight);
+}
+
+//-----------------------------------------------------------------------------
+// ImFontAtlas prebuilt cache
+//-----------------------------------------------------------------------------
+// Layout: [Header][Fonts: ImFontAtlasCacheFont x FontsCount][CustomRects: ImFontAtlasCacheCustomRect x CustomRectsCount][Glyphs][Pixels]
+// Every section starts on a 16-bytes boundary so the blob can be used in place from a memory-mapped file.
+// Structures are stored in native layout and endianness: the header records enough to reject a blob produced on another platform.
+//-----------------------------------------------------------------------------
+
+#define IM_FONT_ATLAS_CACHE_MAGIC       0x53414C54  // 'TLAS'
+#define IM_FONT_ATLAS_CACHE_VERSION     1           // Increment whenever the layout below or the output of the builder changes.
+
+struct ImFontAtlasCacheHeader
+{
+    ImU32   Magic;
+    ImU32   Version;
+    ImU32   ImGuiVersionNum;
+    ImU32   LayoutSizes;        // sizeof() of the structures stored below, to reject data from a different platform/compiler
+    ImU32   InputsHash;         // == ImFontAtlas::CalcInputsHash()
+    ImU32   DataSize;
+    int     TexWidth, TexHeight;
+    ImVec2  TexUvWhitePixel;
+    int     FontsCount;
+    int     CustomRectsCount;
+    int     GlyphsCount;        // Total for all fonts
+    ImU32   FontsOffset, CustomRectsOffset, GlyphsOffset, PixelsOffset;
+};
+
+struct ImFontAtlasCacheFont
+{
+    float   FontSize;
+    float   Ascent, Descent;
+    int     MetricsTotalSurface;
+    int     GlyphsCount;
+    ImWchar EllipsisChar;
+};
+
+struct ImFontAtlasCacheCustomRect
+{
+    unsigned short X, Y;
+};
+
+static inline ImU32 ImFontAtlasCacheAlign(ImU32 offset) { return (offset + 15) & ~15u; }
+static inline ImU32 ImFontAtlasCacheLayoutSizes()      { return (ImU32)sizeof(ImFontAtlasCacheHeader) | ((ImU32)sizeof(ImFontAtlasCacheFont) << 8) | ((ImU32)sizeof(ImFontGlyph) << 16) | ((ImU32)sizeof(ImWchar) << 24); }
+
+// A section of 'count' elements of 'elem_size' bytes at 'offset' must be aligned, and fit between 'min_offset' and 'max_offset'. Return its end offset, 0 if invalid.
+static ImU64 ImFontAtlasCacheValidateSection(ImU32 offset, int count, size_t elem_size, ImU64 min_offset, ImU64 max_offset)
+{
+    if (count < 0 || (offset & 15) != 0 || offset < min_offset)
+        return 0;
+    const ImU64 end = (ImU64)offset + (ImU64)count * elem_size;
+    return (end <= max_offset) ? end : 0;
+}
+
+static ImU32 ImFontAtlasCacheHashCustomRect(const ImFontAtlas* atlas, const ImFontAtlasCustomRect& r, ImU32 hash)
+{
+    float values_f[3] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+    int values_i[4] = { (int)r.ID, r.Width, r.Height, r.Font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find(r.Font)) : -1 };
+    hash = ImHashData(values_f, sizeof(values_f), hash);
+    return ImHashData(values_i, sizeof(values_i), hash);
+}
+
+ImU32 ImFontAtlas::CalcInputsHash() const
+{
+    // FIXME-OPT: Hashing the font data is the bulk of the cost, but still much cheaper than rasterizing and packing it.
+    ImU32 hash = ImHashData(&Flags, sizeof(Flags), IMGUI_VERSION_NUM);
+    hash = ImHashData(&TexDesiredWidth, sizeof(TexDesiredWidth), hash);
+    hash = ImHashData(&TexGlyphPadding, sizeof(TexGlyphPadding), hash);
+    for (int cfg_i = 0; cfg_i < ConfigData.Size; cfg_i++)
+    {
+        const ImFontConfig& cfg = ConfigData[cfg_i];
+        int dst_index = Fonts.index_from_ptr(Fonts.find(cfg.DstFont));
+        float values_f[9] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply, cfg.SignedDistanceFieldSpread };
+        int values_i[10] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.RasterizerFlags, (int)cfg.EllipsisChar, cfg.SignedDistanceField, dst_index };
+        hash = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, hash);
+        hash = ImHashData(values_f, sizeof(values_f), hash);
+        hash = ImHashData(values_i, sizeof(values_i), hash);
+        if (const ImWchar* ranges = cfg.GlyphRanges) // NULL == GetGlyphRangesDefault()
+        {
+            int ranges_count = 0;
+            while (ranges[ranges_count] && ranges[ranges_count + 1])
+                ranges_count += 2;
+            hash = ImHashData(ranges, ranges_count * sizeof(ImWchar), hash);
+        }
+    }
+    for (int rect_i = 0; rect_i < CustomRects.Size; rect_i++)
+        hash = ImFontAtlasCacheHashCustomRect(this, CustomRects[rect_i], hash);
+
+    // Include the default rectangle the builder will append if it isn't registered yet, so the hash is the same before and after building.
+    if (CustomRectIds[0] < 0)
+    {
+        ImFontAtlasCustomRect r;
+        r.ID = FONT_ATLAS_DEFAULT_TEX_DATA_ID;
+        ImFontAtlasBuildGetDefaultCustomRectSize(this, &r.Width, &r.Height);
+        hash = ImFontAtlasCacheHashCustomRect(this, r, hash);
+    }
+    return hash;
+}
+
+bool ImFontAtlas::SaveToMemory(ImVector<unsigned char>* out_data) const
+{
+    IM_ASSERT(out_data != NULL);
+    IM_ASSERT(TexPixelsAlpha8 != NULL && "Atlas needs to be built, and its Alpha8 texture data not cleared, before saving it.");
+    if (TexPixelsAlpha8 == NULL || TexWidth <= 0 || TexHeight <= 0)
+        return false;
+
+    int glyphs_count = 0;
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        glyphs_count += Fonts[font_i]->Glyphs.Size;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = IM_FONT_ATLAS_CACHE_MAGIC;
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    header.ImGuiVersionNum = IMGUI_VERSION_NUM;
+    header.LayoutSizes = ImFontAtlasCacheLayoutSizes();
+    header.InputsHash = CalcInputsHash();
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    header.FontsCount = Fonts.Size;
+    header.CustomRectsCount = CustomRects.Size;
+    header.GlyphsCount = glyphs_count;
+    header.FontsOffset = ImFontAtlasCacheAlign(sizeof(ImFontAtlasCacheHeader));
+    header.CustomRectsOffset = ImFontAtlasCacheAlign(header.FontsOffset + Fonts.Size * sizeof(ImFontAtlasCacheFont));
+    header.GlyphsOffset = ImFontAtlasCacheAlign(header.CustomRectsOffset + CustomRects.Size * sizeof(ImFontAtlasCacheCustomRect));
+    header.PixelsOffset = ImFontAtlasCacheAlign(header.GlyphsOffset + glyphs_count * sizeof(ImFontGlyph));
+    header.DataSize = header.PixelsOffset + (ImU32)(TexWidth * TexHeight);
+
+    out_data->resize((int)header.DataSize);
+    unsigned char* data = out_data->Data;
+    memset(data, 0, header.DataSize);
+    memcpy(data, &header, sizeof(header));
+
+    ImFontAtlasCacheFont* cache_fonts = (ImFontAtlasCacheFont*)(void*)(data + header.FontsOffset);
+    ImFontGlyph* cache_glyphs = (ImFontGlyph*)(void*)(data + header.GlyphsOffset);
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        const ImFont* font = Fonts[font_i];
+        ImFontAtlasCacheFont& cache_font = cache_fonts[font_i];
+        cache_font.FontSize = font->FontSize;
+        cache_font.Ascent = font->Ascent;
+        cache_font.Descent = font->Descent;
+        cache_font.MetricsTotalSurface = font->MetricsTotalSurface;
+        cache_font.GlyphsCount = font->Glyphs.Size;
+        cache_font.EllipsisChar = font->EllipsisChar;
+        if (font->Glyphs.Size > 0)
+            memcpy(cache_glyphs, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+        cache_glyphs += font->Glyphs.Size;
+    }
+    ImFontAtlasCacheCustomRect* cache_rects = (ImFontAtlasCacheCustomRect*)(void*)(data + header.CustomRectsOffset);
+    for (int rect_i = 0; rect_i < CustomRects.Size; rect_i++)
+    {
+        cache_rects[rect_i].X = CustomRects[rect_i].X;
+        cache_rects[rect_i].Y = CustomRects[rect_i].Y;
+    }
+    memcpy(data + header.PixelsOffset, TexPixelsAlpha8, (size_t)(TexWidth * TexHeight));
+    return true;
+}
+
+bool ImFontAtlas::LoadFromMemory(const void* data_void, size_t data_size, bool copy_data)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    IM_ASSERT(ConfigData.Size > 0 && "Add the same fonts as when the data was saved before loading it.");
+    const unsigned char* data = (const unsigned char*)data_void;
+
+    // Validate header. Any mismatch means the data is stale or from elsewhere, and the caller should Build() again.
+    ImFontAtlasCacheHeader header;
+    if (data == NULL || data_size < sizeof(header) || ConfigData.Size == 0)
+        return false;
+    memcpy(&header, data, sizeof(header));
+    if (header.Magic != IM_FONT_ATLAS_CACHE_MAGIC || header.Version != IM_FONT_ATLAS_CACHE_VERSION || header.ImGuiVersionNum != IMGUI_VERSION_NUM || header.LayoutSizes != ImFontAtlasCacheLayoutSizes())
+        return false;
+    const int custom_rects_count = CustomRects.Size + ((CustomRectIds[0] < 0) ? 1 : 0); // Including the default rectangle registered below
+    if (header.DataSize != data_size || header.FontsCount != Fonts.Size || header.CustomRectsCount != custom_rects_count || header.TexWidth <= 0 || header.TexHeight <= 0)
+        return false;
+
+    // Every section must lie within the data, after the previous one
+    ImU64 section_end = sizeof(header);
+    if ((section_end = ImFontAtlasCacheValidateSection(header.FontsOffset, header.FontsCount, sizeof(ImFontAtlasCacheFont), section_end, data_size)) == 0)
+        return false;
+    if ((section_end = ImFontAtlasCacheValidateSection(header.CustomRectsOffset, header.CustomRectsCount, sizeof(ImFontAtlasCacheCustomRect), section_end, data_size)) == 0)
+        return false;
+    if ((section_end = ImFontAtlasCacheValidateSection(header.GlyphsOffset, header.GlyphsCount, sizeof(ImFontGlyph), section_end, data_size)) == 0)
+        return false;
+    if ((ImU64)header.TexWidth * (ImU64)header.TexHeight > 0x7FFFFFFF || ImFontAtlasCacheValidateSection(header.PixelsOffset, header.TexWidth * header.TexHeight, 1, section_end, data_size) != data_size) // Pixels are last
+        return false;
+    const ImFontAtlasCacheFont* cache_fonts = (const ImFontAtlasCacheFont*)(const void*)(data + header.FontsOffset);
+    int glyphs_count = 0;
+    for (int font_i = 0; font_i < header.FontsCount; font_i++)
+    {
+        if (cache_fonts[font_i].GlyphsCount < 0 || cache_fonts[font_i].GlyphsCount > header.GlyphsCount - glyphs_count)
+            return false;
+        glyphs_count += cache_fonts[font_i].GlyphsCount;
+    }
+    if (glyphs_count != header.GlyphsCount || header.InputsHash != CalcInputsHash())
+        return false;
+
+    // Data is valid: only now modify the atlas
+    ImFontAtlasBuildRegisterDefaultCustomRects(this);
+    IM_ASSERT(CustomRects.Size == header.CustomRectsCount);
+
+    // Texture
+    ClearTexData();
+    TexID = (ImTextureID)NULL;
+    TexWidth = header.TexWidth;
+    TexHeight = header.TexHeight;
+    TexUvScale = ImVec2(1.0f / TexWidth, 1.0f / TexHeight);
+    TexUvWhitePixel = header.TexUvWhitePixel;
+    if (copy_data)
+    {
+        TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)(TexWidth * TexHeight));
+        memcpy(TexPixelsAlpha8, data + header.PixelsOffset, (size_t)(TexWidth * TexHeight));
+    }
+    else
+    {
+        TexPixelsAlpha8 = (unsigned char*)(data + header.PixelsOffset);
+        TexPixelsAlpha8External = true;
+    }
+
+    // Custom rectangles
+    const ImFontAtlasCacheCustomRect* cache_rects = (const ImFontAtlasCacheCustomRect*)(const void*)(data + header.CustomRectsOffset);
+    for (int rect_i = 0; rect_i < CustomRects.Size; rect_i++)
+    {
+        CustomRects[rect_i].X = cache_rects[rect_i].X;
+        CustomRects[rect_i].Y = cache_rects[rect_i].Y;
+    }
+
+    // Fonts (same setup sequence as the builders, then glyphs are restored as-is)
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        Fonts[font_i]->ConfigDataCount = 0;
+    for (int cfg_i = 0; cfg_i < ConfigData.Size; cfg_i++)
+        ImFontAtlasBuildSetupFont(this, ConfigData[cfg_i].DstFont, &ConfigData[cfg_i], 0.0f, 0.0f);
+    const ImFontGlyph* cache_glyphs = (const ImFontGlyph*)(const void*)(data + header.GlyphsOffset);
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        ImFont* font = Fonts[font_i];
+        const ImFontAtlasCacheFont& cache_font = cache_fonts[font_i];
+        font->FontSize = cache_font.FontSize;
+        font->Ascent = cache_font.Ascent;
+        font->Descent = cache_font.Descent;
+        font->MetricsTotalSurface = cache_font.MetricsTotalSurface;
+        font->EllipsisChar = cache_font.EllipsisChar;
+        font->Glyphs.resize(cache_font.GlyphsCount);
+        if (cache_font.GlyphsCount > 0)
+            memcpy(font->Glyphs.Data, cache_glyphs, (size_t)font->Glyphs.size_in_bytes());
+        cache_glyphs += cache_font.GlyphsCount;
+        font->BuildLookupTable();
+    }
+    return true;
+}
+
+bool ImFontAtlas::SaveToFile(const char* filename) const
+{
+    ImVector<unsigned char> data;
+    if (!SaveToMemory(&data))
+        return false;
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    bool ret = ImFileWrite(data.Data, 1, (ImU64)data.Size, f) == (ImU64)data.Size;
+    ImFileClose(f);
+    return ret;
+}
+
+bool ImFontAtlas::LoadFromFile(const char* filename)
+{
+    size_t data_size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
+    if (!data)
+        return false;
+    bool ret = LoadFromMemory(data, data_size, true);
+    IM_FREE(data);
+    return ret;
+}
+
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
 {
     for (unsigned int i = 0; i < 256; i++)
@@ -1926,6 +2250,100 @@ struct ImFontBuildDstData
     ImBoolVector        GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Rasterization task: a contiguous chunk of glyphs from one source font.
+// Chunks of a same source write into disjoint rectangles of the texture, so they can be processed in any order and on any thread.
+struct ImFontBuildRenderTask
+{
+    int                 SrcIndex;           // Index into atlas->ConfigData[] and src_tmp_array[]
+    int                 GlyphsStart;        // First glyph (index into GlyphsList[]/Rects[]/PackedChars[])
+    int                 GlyphsCount;
+};
+
+struct ImFontBuildRenderTasksData
+{
+    ImFontAtlas*                    Atlas;
+    const stbtt_pack_context*       PackContext;
+    ImFontBuildSrcData*             SrcTmpArray;
+    ImVector<ImFontBuildRenderTask> Tasks;
+};
+
+static int ImFontAtlasBuildCalcSdfSpread(const ImFontConfig* cfg)
+{
+    return ImMax(1, (int)ImCeil(cfg->SignedDistanceFieldSpread));
+}
+
+// Equivalent of stbtt_PackFontRangesRenderIntoRects() for signed distance fields.
+// Values are 128 on the glyph edge, and move by 127 over 'spread' pixels (increasing inside).
+static void ImFontAtlasBuildRenderSdfGlyphs(const stbtt_pack_context* spc, const stbtt_fontinfo* font_info, const stbtt_pack_range* range, stbrp_rect* rects, int spread)
+{
+    const float scale = (range->font_size > 0) ? stbtt_ScaleForPixelHeight(font_info, range->font_size) : stbtt_ScaleForMappingEmToPixels(font_info, -range->font_size);
+    const float pixel_dist_scale = 127.0f / (float)spread;
+    const int pad = spc->padding;
+    for (int glyph_i = 0; glyph_i < range->num_chars; glyph_i++)
+    {
+        stbrp_rect* r = &rects[glyph_i];
+        stbtt_packedchar* bc = &range->chardata_for_range[glyph_i];
+        if (!r->was_packed)
+            continue;
+        const int glyph = stbtt_FindGlyphIndex(font_info, range->array_of_unicode_codepoints[glyph_i]);
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(font_info, glyph, &advance, &lsb);
+
+        int w = 0, h = 0, x_off = 0, y_off = 0;
+        unsigned char* sdf = stbtt_GetGlyphSDF(font_info, scale, glyph, spread, 128, pixel_dist_scale, &w, &h, &x_off, &y_off);
+        IM_ASSERT(sdf == NULL || (w + pad <= r->w && h + pad <= r->h));
+        const int tx = r->x + pad;
+        const int ty = r->y + pad;
+        for (int y = 0; y < h; y++)
+            memcpy(spc->pixels + tx + (ty + y) * spc->stride_in_bytes, sdf + y * w, (size_t)w);
+        if (sdf)
+            stbtt_FreeSDF(sdf, font_info->userdata);
+
+        bc->x0 = (stbtt_int16)tx;
+        bc->y0 = (stbtt_int16)ty;
+        bc->x1 = (stbtt_int16)(tx + w);
+        bc->y1 = (stbtt_int16)(ty + h);
+        bc->xadvance = scale * advance;
+        bc->xoff = (float)x_off;
+        bc->yoff = (float)y_off;
+        bc->xoff2 = (float)(x_off + w);
+        bc->yoff2 = (float)(y_off + h);
+    }
+}
+
+static void ImFontAtlasBuildRenderTask(void* task_data, int task_index)
+{
+    ImFontBuildRenderTasksData* data = (ImFontBuildRenderTasksData*)task_data;
+    const ImFontBuildRenderTask& task = data->Tasks[task_index];
+    const ImFontConfig& cfg = data->Atlas->ConfigData[task.SrcIndex];
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[task.SrcIndex];
+
+    // stbtt_PackFontRangesRenderIntoRects() temporarily writes the oversampling settings into the pack context, so each task uses its own copy.
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += task.GlyphsStart;
+    pack_range.chardata_for_range += task.GlyphsStart;
+    pack_range.num_chars = task.GlyphsCount;
+    stbrp_rect* rects = &src_tmp.Rects[task.GlyphsStart];
+    if (cfg.SignedDistanceField)
+    {
+        ImFontAtlasBuildRenderSdfGlyphs(&spc, &src_tmp.FontInfo, &pack_range, rects, ImFontAtlasBuildCalcSdfSpread(&cfg));
+        return;
+    }
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < task.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc.pixels, r->x, r->y, r->w, r->h, spc.stride_in_bytes);
+    }
+}
+
 static void UnpackBoolVectorToFlatIndexList(const ImBoolVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2040,7 +2458,6 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
-    int total_surface = 0;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
@@ -2061,49 +2478,56 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.array_of_unicode_codepoints = src_tmp.GlyphsList.Data;
         src_tmp.PackRange.num_chars = src_tmp.GlyphsList.Size;
         src_tmp.PackRange.chardata_for_range = src_tmp.PackedChars;
-        src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
-        src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
+        src_tmp.PackRange.h_oversample = (unsigned char)(cfg.SignedDistanceField ? 1 : cfg.OversampleH);
+        src_tmp.PackRange.v_oversample = (unsigned char)(cfg.SignedDistanceField ? 1 : cfg.OversampleV);
 
         // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
+        // Distance fields are extended by their spread on each side (this matches the bounding box computed by stbtt_GetGlyphSDF)
         const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
         const int padding = atlas->TexGlyphPadding;
+        const int sdf_spread = cfg.SignedDistanceField ? ImFontAtlasBuildCalcSdfSpread(&cfg) : 0;
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
         {
             int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * src_tmp.PackRange.h_oversample, scale * src_tmp.PackRange.v_oversample, 0, 0, &x0, &y0, &x1, &y1);
+            if (sdf_spread > 0 && x0 != x1 && y0 != y1)
+            {
+                x0 -= sdf_spread; y0 -= sdf_spread;
+                x1 += sdf_spread; y1 += sdf_spread;
+            }
+            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + src_tmp.PackRange.h_oversample - 1);
+            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + src_tmp.PackRange.v_oversample - 1);
         }
     }
 
-    // We need a width for the skyline algorithm, any width!
-    // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
-    // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
-    const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
-    atlas->TexHeight = 0;
-    if (atlas->TexDesiredWidth > 0)
-        atlas->TexWidth = atlas->TexDesiredWidth;
-    else
-        atlas->TexWidth = (surface_sqrt >= 4096*0.7f) ? 4096 : (surface_sqrt >= 2048*0.7f) ? 2048 : (surface_sqrt >= 1024*0.7f) ? 1024 : 512;
+    // Select texture width
+    const int TEX_HEIGHT_MAX = 1024 * 32;
+    // stbtt_PackBegin() packs into (TexWidth - padding) x (TEX_HEIGHT_MAX - padding)
+    const bool tight_packing = (atlas->Flags & ImFontAtlasFlags_TightPacking) != 0;
+    const int pack_heuristic = tight_packing ? STBRP_HEURISTIC_Skyline_BF_sortHeight : STBRP_HEURISTIC_Skyline_default;
+    ImFontAtlasBuildSelectTexWidth(atlas, buf_rects.Data, buf_rects.Size, TEX_HEIGHT_MAX, atlas->TexGlyphPadding, pack_heuristic);
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    const int TEX_HEIGHT_MAX = 1024 * 32;
     stbtt_pack_context spc = {};
     stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
+    stbrp_setup_heuristic((stbrp_context*)spc.pack_info, pack_heuristic);
     ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
 
     // 6. Pack each source font. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
+    // With ImFontAtlasFlags_TightPacking all sources are packed in a single call, so glyphs get sorted by height across fonts.
+    if (tight_packing)
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, buf_rects.Data, buf_rects.Size);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
 
-        stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
+        if (!tight_packing)
+            stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
 
         // Extend texture height and mark missing glyphs as non-packed so we won't render them.
         // FIXME: We are not handling packing failure here (would happen if we got off TEX_HEIGHT_MAX or if a single if larger than TexWidth?)
@@ -2121,27 +2545,25 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Glyphs are split into fixed-size chunks, which are rasterized serially or dispatched through atlas->BuildParallelFor.
+    // Packing is already done at this point, so the output doesn't depend on the order in which chunks are processed.
+    const int GLYPHS_PER_RENDER_TASK = 128;
+    ImFontBuildRenderTasksData render_tasks_data;
+    render_tasks_data.Atlas = atlas;
+    render_tasks_data.PackContext = &spc;
+    render_tasks_data.SrcTmpArray = src_tmp_array.Data;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += GLYPHS_PER_RENDER_TASK)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRenderTask task;
+            task.SrcIndex = src_i;
+            task.GlyphsStart = glyph_i;
+            task.GlyphsCount = ImMin(GLYPHS_PER_RENDER_TASK, src_tmp_array[src_i].GlyphsCount - glyph_i);
+            render_tasks_data.Tasks.push_back(task);
         }
-        src_tmp.Rects = NULL;
-    }
+    ImFontAtlasBuildParallelFor(atlas, render_tasks_data.Tasks.Size, ImFontAtlasBuildRenderTask, &render_tasks_data);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -2194,14 +2616,45 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     return true;
 }
 
+// Tasks dispatched through atlas->BuildParallelFor run on other threads: account their allocations to the font tag there too.
+struct ImFontAtlasBuildParallelForData
+{
+    void                (*TaskFunc)(void* task_data, int task_index);
+    void*               TaskData;
+};
+
+static void ImFontAtlasBuildParallelForTask(void* task_data, int task_index)
+{
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
+    ImFontAtlasBuildParallelForData* data = (ImFontAtlasBuildParallelForData*)task_data;
+    data->TaskFunc(data->TaskData, task_index);
+}
+
+// Run independent build tasks, through the user-provided atlas->BuildParallelFor when available.
+// Tasks must not touch the ImGui context. They may use IM_ALLOC()/IM_FREE(), which are safe to call from any thread,
+// and memory they allocate may outlive them (e.g. the FreeType render tasks leave their bitmap buffers to the blit tasks).
+void ImFontAtlasBuildParallelFor(ImFontAtlas* atlas, int tasks_count, void (*task_func)(void* task_data, int task_index), void* task_data)
+{
+    if (atlas->BuildParallelFor == NULL || tasks_count <= 1)
+    {
+        for (int task_i = 0; task_i < tasks_count; task_i++)
+            task_func(task_data, task_i);
+        return;
+    }
+
+    ImFontAtlasBuildParallelForData data;
+    data.TaskFunc = task_func;
+    data.TaskData = task_data;
+    atlas->BuildParallelFor(tasks_count, ImFontAtlasBuildParallelForTask, &data, atlas->BuildParallelForUserData);
+}
+
 void ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtlas* atlas)
 {
     if (atlas->CustomRectIds[0] >= 0)
         return;
-    if (!(atlas->Flags & ImFontAtlasFlags_NoMouseCursors))
-        atlas->CustomRectIds[0] = atlas->AddCustomRectRegular(FONT_ATLAS_DEFAULT_TEX_DATA_ID, FONT_ATLAS_DEFAULT_TEX_DATA_W_HALF*2+1, FONT_ATLAS_DEFAULT_TEX_DATA_H);
-    else
-        atlas->CustomRectIds[0] = atlas->AddCustomRectRegular(FONT_ATLAS_DEFAULT_TEX_DATA_ID, 2, 2);
+    unsigned short w, h;
+    ImFontAtlasBuildGetDefaultCustomRectSize(atlas, &w, &h);
+    atlas->CustomRectIds[0] = atlas->AddCustomRectRegular(FONT_ATLAS_DEFAULT_TEX_DATA_ID, w, h);
 }
 
 void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent)
@@ -2245,6 +2698,94 @@ void ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opa
         }
 }
 
+// Try packing all rectangles at a given width, return the resulting texture height or -1 if they don't fit.
+// Same setup as step 5 and 6 of the builders with ImFontAtlasFlags_TightPacking: see ImFontAtlasBuildSelectTexWidth() for 'pack_inset' and 'pack_heuristic'.
+// Custom rects are packed first like ImFontAtlasBuildPackCustomRects() does, but into 'custom_rects' so atlas->CustomRects keeps no position from a trial.
+static int ImFontAtlasBuildPackTrial(ImFontAtlas* atlas, stbrp_rect* rects, int rects_count, int tex_width, int tex_height_max, int pack_inset, int pack_heuristic, ImVector<stbrp_node>& nodes, ImVector<stbrp_rect>& custom_rects)
+{
+    nodes.resize(tex_width - atlas->TexGlyphPadding);
+    stbrp_context pack_context;
+    stbrp_init_target(&pack_context, tex_width - pack_inset, tex_height_max - pack_inset, nodes.Data, nodes.Size);
+    stbrp_setup_heuristic(&pack_context, pack_heuristic);
+    custom_rects.resize(atlas->CustomRects.Size);
+    memset(custom_rects.Data, 0, (size_t)custom_rects.size_in_bytes());
+    for (int i = 0; i < custom_rects.Size; i++)
+    {
+        custom_rects[i].w = atlas->CustomRects[i].Width;
+        custom_rects[i].h = atlas->CustomRects[i].Height;
+    }
+    if (custom_rects.Size > 0)
+        stbrp_pack_rects(&pack_context, custom_rects.Data, custom_rects.Size);
+    stbrp_pack_rects(&pack_context, rects, rects_count);
+    int tex_height = 0;
+    for (int i = 0; i < custom_rects.Size; i++)
+    {
+        if (!custom_rects[i].was_packed)
+            return -1;
+        tex_height = ImMax(tex_height, custom_rects[i].y + custom_rects[i].h);
+    }
+    for (int i = 0; i < rects_count; i++)
+    {
+        if (!rects[i].was_packed)
+            return -1;
+        tex_height = ImMax(tex_height, rects[i].y + rects[i].h);
+    }
+    return (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (tex_height + 1) : ImUpperPowerOfTwo(tex_height);
+}
+
+// We need a width for the skyline algorithm, any width!
+// The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
+// User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
+// With ImFontAtlasFlags_TightPacking we instead pack at every power-of-two width and keep the one giving the smallest texture.
+// 'stbrp_rects_opaque' points to the glyph rectangles (stbrp_rect) of all sources. Their positions are overwritten, you need to pack them again.
+// The trials pack the way the builder does: into (TexWidth - pack_inset) x (tex_height_max - pack_inset) with (TexWidth - TexGlyphPadding) nodes, using 'pack_heuristic'.
+void ImFontAtlasBuildSelectTexWidth(ImFontAtlas* atlas, void* stbrp_rects_opaque, int rects_count, int tex_height_max, int pack_inset, int pack_heuristic)
+{
+    stbrp_rect* rects = (stbrp_rect*)stbrp_rects_opaque;
+    atlas->TexHeight = 0;
+    if (atlas->TexDesiredWidth > 0)
+    {
+        atlas->TexWidth = atlas->TexDesiredWidth;
+        return;
+    }
+
+    int total_surface = 0;
+    for (int i = 0; i < rects_count; i++)
+        total_surface += rects[i].w * rects[i].h;
+    const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
+    atlas->TexWidth = (surface_sqrt >= 4096*0.7f) ? 4096 : (surface_sqrt >= 2048*0.7f) ? 2048 : (surface_sqrt >= 1024*0.7f) ? 1024 : 512;
+    if (!(atlas->Flags & ImFontAtlasFlags_TightPacking))
+        return;
+
+    // Widths narrower than the widest rectangle (e.g. the default mouse cursors data) can't hold it
+    int rects_max_width = 0;
+    for (int i = 0; i < rects_count; i++)
+        rects_max_width = ImMax(rects_max_width, (int)rects[i].w);
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+        rects_max_width = ImMax(rects_max_width, (int)atlas->CustomRects[i].Width);
+
+    ImVector<stbrp_node> nodes;
+    ImVector<stbrp_rect> custom_rects;
+    int best_width = 0, best_height = 0;
+    for (int tex_width = 128; tex_width <= 4096; tex_width *= 2)
+    {
+        if (tex_width - pack_inset < rects_max_width)
+            continue;
+        const int tex_height = ImFontAtlasBuildPackTrial(atlas, rects, rects_count, tex_width, tex_height_max, pack_inset, pack_heuristic, nodes, custom_rects);
+        if (tex_height < 0)
+            continue;
+        const int area = tex_width * tex_height, best_area = best_width * best_height;
+        if (best_width == 0 || area < best_area || (area == best_area && ImMax(tex_width, tex_height) < ImMax(best_width, best_height)))
+        {
+            best_width = tex_width;
+            best_height = tex_height;
+        }
+    }
+    if (best_width > 0)
+        atlas->TexWidth = best_width;
+    atlas->TexHeight = 0;
+}
+
 static void ImFontAtlasBuildRenderDefaultTexData(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->CustomRectIds[0] >= 0);
@@ -2606,6 +3147,7 @@ void    ImFont::ClearOutputData()
     FontSize = 0.0f;
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    IndexPageMap.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     FallbackGlyph = NULL;
@@ -2617,20 +3159,22 @@ void    ImFont::ClearOutputData()
 
 void ImFont::BuildLookupTable()
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     int max_codepoint = 0;
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
 
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    IndexPageMap.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
-        int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (ImWchar)i;
+        int slot = AllocIndexSlot(Glyphs[i].Codepoint);
+        IndexAdvanceX[slot] = Glyphs[i].AdvanceX;
+        IndexLookup[slot] = (ImWchar)i;
     }
 
     // Create a glyph to handle TAB
@@ -2643,14 +3187,15 @@ void ImFont::BuildLookupTable()
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size-1);
+        int slot = AllocIndexSlot(tab_glyph.Codepoint);
+        IndexAdvanceX[slot] = (float)tab_glyph.AdvanceX;
+        IndexLookup[slot] = (ImWchar)(Glyphs.Size-1);
     }
 
     FallbackGlyph = FindGlyphNoFallback(FallbackChar);
     FallbackAdvanceX = FallbackGlyph ? FallbackGlyph->AdvanceX : 0.0f;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
+    for (int i = 0; i < IndexLookup.Size; i++)
+        if (IndexLookup[i] == (ImWchar)-1)
             IndexAdvanceX[i] = FallbackAdvanceX;
 }
 
@@ -2660,19 +3205,39 @@ void ImFont::SetFallbackChar(ImWchar c)
     BuildLookupTable();
 }
 
+// Make the page map cover code points [0..new_size). Blocks without glyphs all point to page 0, which stays empty.
 void ImFont::GrowIndex(int new_size)
 {
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (ImWchar)-1);
+    if (IndexLookup.Size == 0)
+    {
+        IndexAdvanceX.resize(IM_FONT_INDEX_PAGE_SIZE, FallbackAdvanceX);
+        IndexLookup.resize(IM_FONT_INDEX_PAGE_SIZE, (ImWchar)-1);
+    }
+    int new_pages_count = (new_size + IM_FONT_INDEX_PAGE_SIZE - 1) >> IM_FONT_INDEX_PAGE_SHIFT;
+    if (new_pages_count > IndexPageMap.Size)
+        IndexPageMap.resize(new_pages_count, (ImU16)0);
+}
+
+// Return the slot of 'c' in IndexAdvanceX/IndexLookup, allocating a page for its block if it doesn't have one yet.
+int ImFont::AllocIndexSlot(ImWchar c)
+{
+    GrowIndex((int)c + 1);
+    ImU16& page = IndexPageMap[(int)c >> IM_FONT_INDEX_PAGE_SHIFT];
+    if (page == 0)
+    {
+        page = (ImU16)(IndexLookup.Size >> IM_FONT_INDEX_PAGE_SHIFT);
+        IndexAdvanceX.resize(IndexAdvanceX.Size + IM_FONT_INDEX_PAGE_SIZE, FallbackAdvanceX);
+        IndexLookup.resize(IndexLookup.Size + IM_FONT_INDEX_PAGE_SIZE, (ImWchar)-1);
+    }
+    return GetIndexSlot(c);
 }
 
 // x0/y0/x1/y1 are offset from the character upper-left layout position, in pixels. Therefore x0/y0 are often fairly close to zero.
 // Not to be mistaken with texture coordinates, which are held by u0/v0/u1/v1 in normalized format (0.0..1.0 on each texture axis).
 void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     Glyphs.resize(Glyphs.Size + 1);
     ImFontGlyph& glyph = Glyphs.back();
     glyph.Codepoint = (ImWchar)codepoint;
@@ -2696,24 +3261,29 @@ void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1,
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Font);
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    unsigned int index_size = (unsigned int)IndexLookup.Size;
+    int dst_slot = GetIndexSlot(dst);
+    int src_slot = GetIndexSlot(src);
 
-    if (dst < index_size && IndexLookup.Data[dst] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_slot >= 0 && IndexLookup.Data[dst_slot] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (src_slot < 0 && dst_slot < 0) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    ImWchar src_lookup = (src_slot >= 0) ? IndexLookup.Data[src_slot] : (ImWchar)-1;
+    float src_advance_x = (src_slot >= 0) ? IndexAdvanceX.Data[src_slot] : 1.0f;
+    dst_slot = AllocIndexSlot(dst);
+    IndexLookup[dst_slot] = src_lookup;
+    IndexAdvanceX[dst_slot] = src_advance_x;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= IndexLookup.Size)
+    const int slot = GetIndexSlot(c);
+    if (slot < 0)
         return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = IndexLookup.Data[slot];
     if (i == (ImWchar)-1)
         return FallbackGlyph;
     return &Glyphs.Data[i];
@@ -2721,9 +3291,10 @@ const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
 {
-    if (c >= IndexLookup.Size)
+    const int slot = GetIndexSlot(c);
+    if (slot < 0)
         return NULL;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = IndexLookup.Data[slot];
     if (i == (ImWchar)-1)
         return NULL;
     return &Glyphs.Data[i];
@@ -2783,7 +3354,8 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
+        const int slot = GetIndexSlot(c);
+        const float char_width = (slot >= 0 ? IndexAdvanceX.Data[slot] : FallbackAdvanceX);
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -2900,7 +3472,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+        const int slot = GetIndexSlot(c);
+        const float char_width = (slot >= 0 ? IndexAdvanceX.Data[slot] : FallbackAdvanceX) * scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -36,6 +36,9 @@ Index of this file:
 #include <stdlib.h>     // NULL, malloc, free, qsort, atoi, atof
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
+#if defined(_MSC_VER)
+#include <intrin.h>     // _InterlockedExchange, _InterlockedCompareExchange
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -81,19 +84,25 @@ struct ImGuiColorMod;               // Stacked color modifier, backup of modifie
 struct ImGuiColumnData;             // Storage data for a single column
 struct ImGuiColumns;                // Storage data for a columns set
 struct ImGuiContext;                // Main Dear ImGui context
+struct ImGuiDataTableSettings;      // Storage for the column widths of an ImGuiDataTable, saved in the .ini file
+struct ImGuiDataTableSortTask;      // Sort of an ImGuiDataTable, possibly running on another thread
 struct ImGuiDataTypeInfo;           // Type information associated to a ImGuiDataType enum
 struct ImGuiGroupData;              // Stacked storage data for BeginGroup()/EndGroup()
 struct ImGuiInputTextState;         // Internal state of the currently focused/edited text input box
 struct ImGuiItemHoveredDataBackup;  // Backup and restore IsItemHovered() internal data
+struct ImGuiListClipperState;       // Storage for ImGuiListClipperVariable
 struct ImGuiMenuColumns;            // Simple column measurement, currently used for MenuItem() only
 struct ImGuiNavMoveResult;          // Result of a directional navigation move query result
 struct ImGuiNextWindowData;         // Storage for SetNextWindow** functions
 struct ImGuiNextItemData;           // Storage for SetNextItem** functions
+struct ImGuiPlotState;              // Storage for a decimated plot
 struct ImGuiPopupData;              // Storage for current popup stack
 struct ImGuiSettingsHandler;        // Storage for one type registered in the .ini file
+struct ImGuiSettingsSaveTask;       // Asynchronous .ini save in flight
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
 struct ImGuiTabBar;                 // Storage for a tab bar
 struct ImGuiTabItem;                // Storage for a tab item (within a tab bar)
+struct ImGuiTreeClipperState;       // Storage for ImGuiTreeClipper
 struct ImGuiWindow;                 // Storage for one window
 struct ImGuiWindowTempData;         // Temporary storage for one window (that's the data which in theory we could ditch at the end of the frame)
 struct ImGuiWindowSettings;         // Storage for a window .ini settings (we keep one of those even if the actual window wasn't instanced during this session)
@@ -127,8 +136,7 @@ namespace ImStb
 #define STB_TEXTEDIT_STRING             ImGuiInputTextState
 #define STB_TEXTEDIT_CHARTYPE           ImWchar
 #define STB_TEXTEDIT_GETWIDTH_NEWLINE   -1.0f
-#define STB_TEXTEDIT_UNDOSTATECOUNT     99
-#define STB_TEXTEDIT_UNDOCHARCOUNT      999
+#define STB_TEXTEDIT_NO_UNDO            // We record undo history ourselves, see ImGuiInputTextUndoStack
 #include "imstb_textedit.h"
 
 } // namespace ImStb
@@ -166,6 +174,15 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 #define IM_ASSERT_PARANOID(_EXPR)
 #endif
 
+// Memory accounting
+// Allocations made while the scope is alive are accounted to the given ImGuiMemTag (only when IMGUI_ENABLE_MEMORY_TAGS is defined in imconfig.h)
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+struct IMGUI_API ImGuiMemTagScope { ImGuiMemTag BackupTag; ImGuiMemTagScope(ImGuiMemTag tag); ~ImGuiMemTagScope(); };
+#define IMGUI_MEM_TAG_SCOPE(_TAG)       ImGuiMemTagScope im_mem_tag_scope(_TAG)
+#else
+#define IMGUI_MEM_TAG_SCOPE(_TAG)
+#endif
+
 // Error handling
 // Down the line in some frameworks/languages we would like to have a way to redirect those to the programmer and recover from more faults.
 #ifndef IM_ASSERT_USER_ERROR
@@ -199,6 +216,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 //-----------------------------------------------------------------------------
 // - Helpers: Misc
 // - Helpers: Bit manipulation
+// - Helpers: Atomics
 // - Helpers: String, Formatting
 // - Helpers: UTF-8 <> wchar conversions
 // - Helpers: ImVec2/ImVec4 operators
@@ -207,6 +225,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // - Helper: ImBoolVector
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
+// - Helper: ImLinearArena
 //-----------------------------------------------------------------------------
 
 // Helpers: Misc
@@ -216,11 +235,48 @@ IMGUI_API ImU32         ImHashStr(const char* data, size_t data_size = 0, ImU32
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline ImU32     ImHash(const void* data, int size, ImU32 seed = 0) { return size ? ImHashData(data, (size_t)size, seed) : ImHashStr((const char*)data, 0, seed); } // [moved to ImHashStr/ImHashData in 1.68]
 #endif
+template<typename T> static inline void ImVectorShrink(ImVector<T>* v, int capacity) { if (capacity < v->Size) capacity = v->Size; if (capacity >= v->Capacity) return; ImVector<T> tmp; if (capacity > 0) { tmp.reserve(capacity); tmp.resize(v->Size); if (v->Size > 0) memcpy(tmp.Data, v->Data, (size_t)v->Size * sizeof(T)); } v->swap(tmp); } // Reallocate to a smaller capacity (never below size), contents are kept
+
+// Helper: CallbackResize handler for std::string-like types (c_str(), capacity(), reserve(), resize()), shared by the std::string wrappers of misc/cpp/imgui_stdlib.cpp and imgui_additions.cpp.
+// We grow the capacity geometrically ourselves, as the growth policy of std::string::resize() is implementation defined and may reallocate on every keystroke.
+// Shrinking keeps the capacity, so the string doesn't reallocate when it grows back.
+template<typename T> static inline void ImInputTextResizeString(ImGuiInputTextCallbackData* data, T* str)
+{
+    IM_ASSERT(data->Buf == str->c_str());
+    const size_t new_len = (size_t)data->BufTextLen;
+    if (new_len > str->capacity())
+        str->reserve(new_len > str->capacity() * 3 / 2 ? new_len : str->capacity() * 3 / 2);
+    str->resize(new_len);
+    data->Buf = (char*)str->c_str();
+    data->BufSize = (int)str->capacity() + 1;
+}
 
 // Helpers: Bit manipulation
 static inline bool      ImIsPowerOfTwo(int v)           { return v != 0 && (v & (v - 1)) == 0; }
 static inline int       ImUpperPowerOfTwo(int v)        { v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v; }
 
+// Helpers: Atomics (for values shared with another thread: acquire loads, release stores. ImAtomicAdd and ImAtomicCompareExchange on int/size_t are relaxed, for counters. ImAtomicAdd returns the new value, ImAtomicCompareExchange the previous one)
+#if defined(_MSC_VER)
+static inline long      ImAtomicLoad(volatile long* p)          { return _InterlockedCompareExchange(p, 0, 0); }
+static inline void      ImAtomicStore(volatile long* p, long v) { _InterlockedExchange(p, v); }
+static inline long      ImAtomicCompareExchange(volatile long* p, long expected, long desired) { return _InterlockedCompareExchange(p, desired, expected); }
+static inline int       ImAtomicAdd(volatile int* p, int v)     { return (int)_InterlockedExchangeAdd((volatile long*)p, (long)v) + v; }
+#ifdef _WIN64
+static inline size_t    ImAtomicAdd(volatile size_t* p, size_t v)                                   { return (size_t)_InterlockedExchangeAdd64((volatile __int64*)p, (__int64)v) + v; }
+static inline size_t    ImAtomicCompareExchange(volatile size_t* p, size_t expected, size_t desired) { return (size_t)_InterlockedCompareExchange64((volatile __int64*)p, (__int64)desired, (__int64)expected); }
+#else
+static inline size_t    ImAtomicAdd(volatile size_t* p, size_t v)                                   { return (size_t)_InterlockedExchangeAdd((volatile long*)p, (long)v) + v; }
+static inline size_t    ImAtomicCompareExchange(volatile size_t* p, size_t expected, size_t desired) { return (size_t)_InterlockedCompareExchange((volatile long*)p, (long)desired, (long)expected); }
+#endif
+#else
+static inline long      ImAtomicLoad(volatile long* p)          { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline void      ImAtomicStore(volatile long* p, long v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static inline long      ImAtomicCompareExchange(volatile long* p, long expected, long desired) { __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); return expected; }
+static inline int       ImAtomicAdd(volatile int* p, int v)     { return __atomic_add_fetch(p, v, __ATOMIC_RELAXED); }
+static inline size_t    ImAtomicAdd(volatile size_t* p, size_t v)                                   { return __atomic_add_fetch(p, v, __ATOMIC_RELAXED); }
+static inline size_t    ImAtomicCompareExchange(volatile size_t* p, size_t expected, size_t desired) { __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED); return expected; }
+#endif
+
 // Helpers: String, Formatting
 IMGUI_API int           ImStricmp(const char* str1, const char* str2);
 IMGUI_API int           ImStrnicmp(const char* str1, const char* str2, size_t count);
@@ -279,6 +335,7 @@ static inline bool          ImFileClose(ImFileHandle)
 static inline ImU64         ImFileGetSize(ImFileHandle)                             { return (ImU64)-1; }
 static inline ImU64         ImFileRead(void*, ImU64, ImU64, ImFileHandle)           { return 0; }
 static inline ImU64         ImFileWrite(const void*, ImU64, ImU64, ImFileHandle)    { return 0; }
+static inline bool          ImFileRename(const char*, const char*)                  { return false; }
 #endif
 
 #ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
@@ -288,6 +345,7 @@ IMGUI_API bool              ImFileClose(ImFileHandle file);
 IMGUI_API ImU64             ImFileGetSize(ImFileHandle file);
 IMGUI_API ImU64             ImFileRead(void* data, ImU64 size, ImU64 count, ImFileHandle file);
 IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 count, ImFileHandle file);
+IMGUI_API bool              ImFileRename(const char* old_filename, const char* new_filename);  // Replace new_filename if it exists
 #else
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
@@ -408,6 +466,29 @@ struct IMGUI_API ImChunkStream
     T*      ptr_from_offset(int off)    { IM_ASSERT(off >= 4 && off < Buf.Size); return (T*)(void*)(Buf.Data + off); }
 };
 
+// Helper: ImLinearArena
+// Linear allocator: allocations are carved out of large blocks and can't be freed individually, reset() rewinds everything at once.
+// Blocks are kept across reset() so once warmed up a frame worth of transient allocations doesn't hit MemAlloc() at all.
+// Requests larger than BlockSize are rare (e.g. a large clipboard paste): they go to MemAlloc() and are released by reset().
+// Allocations are aligned on 16 bytes boundaries.
+struct IMGUI_API ImLinearArena
+{
+    ImVector<char*> Blocks;
+    ImVector<int>   BlocksSize;
+    ImVector<void*> LargeAllocs;        // Requests larger than BlockSize since the last reset()
+    int             CurrBlock;          // Block we are currently allocating from
+    int             CurrOffset;         // Offset of the next allocation in the current block
+    int             BlockSize;          // Size of new blocks
+    int             AllocCount;         // Number of allocations since the last reset()
+
+    ImLinearArena()             { CurrBlock = CurrOffset = AllocCount = 0; BlockSize = 16 * 1024; }
+    ~ImLinearArena()            { clear(); }
+    void*   alloc(size_t sz);
+    void    reset();
+    void    clear();            // Release all blocks
+    int     capacity() const    { int sz = 0; for (int n = 0; n < BlocksSize.Size; n++) sz += BlocksSize[n]; return sz; }
+};
+
 //-----------------------------------------------------------------------------
 // Misc data structures
 //-----------------------------------------------------------------------------
@@ -640,6 +721,20 @@ enum ImGuiPopupPositionPolicy
     ImGuiPopupPositionPolicy_ComboBox
 };
 
+// State of a task handed to a user ImGuiRunAsyncFunc (io.IniSaveAsync, ImGuiDataTable::SortAsync). The last of the owner and task_func() to use the task frees it.
+// - task_func() runs a Pending task (Running -> Done), the owner then frees it.
+// - When the owner needs to wait for a task which didn't start yet (it may be queued behind us on the same thread), it claims it and runs it inline (Claimed -> Orphaned).
+//   The deferred task_func() call frees an Orphaned task, or marks a still Claimed task Done so the owner frees it once finished.
+// - An owner dropping a Pending task marks it Orphaned directly.
+enum ImGuiAsyncTaskState
+{
+    ImGuiAsyncTaskState_Pending,
+    ImGuiAsyncTaskState_Running,
+    ImGuiAsyncTaskState_Claimed,
+    ImGuiAsyncTaskState_Done,
+    ImGuiAsyncTaskState_Orphaned
+};
+
 // 1D vector (this odd construct is used to facilitate the transition between 1D and 2D, and the maintenance of some branches/patches)
 struct ImVec1
 {
@@ -745,18 +840,48 @@ struct IMGUI_API ImGuiMenuColumns
     float       CalcExtraSpace(float avail_w) const;
 };
 
+// Undo/redo record of the currently edited text input box: an edit replaced DeletedLen characters at Where with InsertedLen characters.
+// A record only stores the text which isn't in the buffer when it gets applied (deleted text for undo, inserted text for redo).
+struct ImGuiInputTextUndoRecord
+{
+    int                     Where;                  // position in TextW
+    int                     DeletedLen;             // wchar count removed at Where by the edit
+    int                     InsertedLen;            // wchar count inserted at Where by the edit
+    int                     TextOffset;             // offset of the stored text in ImGuiInputTextUndoStack::Text
+    int                     TextSize;               // size of the stored text in bytes, as stored
+    int                     TextSizeA;              // size of the stored text in UTF-8 bytes (== TextSize when not compressed)
+    bool                    Compressed;             // stored text is compressed (large spans only, see io.ConfigInputTextUndoCompress)
+};
+
+// Stack of undo/redo records, with their text packed in a single buffer
+struct ImGuiInputTextUndoStack
+{
+    ImVector<ImGuiInputTextUndoRecord> Records;
+    ImVector<char>          Text;
+
+    void        clear()                     { Records.clear(); Text.clear(); }
+    int         GetMemoryUsage() const      { return Records.Size * (int)sizeof(ImGuiInputTextUndoRecord) + Text.Size; }
+};
+
 // Internal state of the currently focused/edited text input box
 struct IMGUI_API ImGuiInputTextState
 {
     ImGuiID                 ID;                     // widget id owning the text state
     int                     CurLenW, CurLenA;       // we need to maintain our buffer length in both UTF-8 and wchar format. UTF-8 len is valid even if TextA is not.
     ImVector<ImWchar>       TextW;                  // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
-    ImVector<char>          TextA;                  // temporary UTF8 buffer for callbacks and other operations. this is not updated in every code-path! size=capacity.
+    ImVector<char>          TextA;                  // UTF8 copy of TextW for callbacks and other operations, kept in sync by the stb_textedit callbacks once valid. in read-only mode: copy of the user buffer TextW was converted from.
     ImVector<char>          InitialTextA;           // backup of end-user buffer at the time of focus (in UTF-8, unaltered)
     bool                    TextAIsValid;           // temporary UTF8 buffer is not initially valid before we make the widget active (until then we pull the data from user argument)
+    bool                    TextEdited;             // text was modified since we last copied it back to the user buffer
+    int                     OffsetCacheW, OffsetCacheA; // last position converted by GetUtf8Offset(), in wchar and UTF-8 units. conversions near it only scan the distance in-between.
+    ImVector<int>           LineStarts;             // index in TextW of the first character of each line, kept up to date by the stb_textedit callbacks. size=lines count.
+    ImVector<char>          VisibleTextA;           // temporary UTF8 copy of the lines visible in a multi-line widget, so we only render those
     int                     BufCapacityA;           // end-user buffer capacity
     float                   ScrollX;                // horizontal scrolling/offset
     ImStb::STB_TexteditState Stb;                   // state for stb_textedit.h
+    ImGuiInputTextUndoStack UndoStack;              // edits which can be undone, oldest first. bounded by io.ConfigInputTextUndoMemoryBudget along with RedoStack
+    ImGuiInputTextUndoStack RedoStack;              // undone edits which can be redone, next one last
+    bool                    UndoMergeAllowed;       // the next edit may be merged into the last undo record (e.g. consecutive typing). cleared by cursor moves, pastes, undo/redo..
     float                   CursorAnim;             // timer for cursor blink, reset on every user action so the cursor reappears immediately
     bool                    CursorFollow;           // set when we want scrolling to follow the current cursor position (not always!)
     bool                    SelectedAllMouseLock;   // after a double-click to select all, we ignore further mouse drags to update selection
@@ -765,11 +890,27 @@ struct IMGUI_API ImGuiInputTextState
     void*                   UserCallbackData;       // "
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
-    int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
-    int         GetRedoAvailCount() const   { return STB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; OffsetCacheW = OffsetCacheA = 0; LineIndexRebuild(); CursorClamp(); }
+    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); LineStarts.clear(); VisibleTextA.clear(); UndoStack.clear(); RedoStack.clear(); }
+    int         GetUndoAvailCount() const   { return UndoStack.Records.Size; }
+    int         GetRedoAvailCount() const   { return RedoStack.Records.Size; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
+    int         GetUtf8Offset(int pos_w);   // Convert a position in TextW to a byte offset in its UTF-8 representation
+    void        InvalidateOffsetCache()     { OffsetCacheW = OffsetCacheA = 0; }
+
+    // Line index
+    void        LineIndexRebuild();
+    int         LineIndexFindLine(int pos_w) const;     // Line containing a position in TextW
+    void        LineIndexOnInsert(int pos_w, const ImWchar* text, int text_len);
+    void        LineIndexOnDelete(int pos_w, int n);
+
+    // Undo/Redo
+    void        UndoRecordDelete(int pos_w, int n);     // Called before deleting characters from TextW
+    void        UndoRecordInsert(int pos_w, int n);     // Called after inserting characters in TextW
+    void        UndoClear()                 { UndoStack.clear(); RedoStack.clear(); UndoMergeAllowed = false; }
+    void        UndoTrim();                             // Discard the oldest records until we fit in io.ConfigInputTextUndoMemoryBudget
+    bool        Undo();
+    bool        Redo();
 
     // Cursor & Selection
     void        CursorAnimReset()           { CursorAnim = -0.30f; }                                   // After a user-input the cursor stays on for a while without blinking
@@ -793,6 +934,16 @@ struct ImGuiWindowSettings
     char* GetName()             { return (char*)(this + 1); }
 };
 
+// Column widths of an ImGuiDataTable. Allocated in a single chunk, followed by the offsets.
+struct ImGuiDataTableSettings
+{
+    ImGuiID     ID;                 // ID of the header columns set, 0 if the entry was superseded
+    int         ColumnsCount;
+
+    ImGuiDataTableSettings()    { ID = 0; ColumnsCount = 0; }
+    float* GetOffsets()         { return (float*)(this + 1); }   // ColumnsCount + 1 normalized column offsets (see ImGuiColumnData::OffsetNorm)
+};
+
 struct ImGuiSettingsHandler
 {
     const char* TypeName;       // Short description stored in .ini file. Disallowed characters: '[' ']'
@@ -800,11 +951,38 @@ struct ImGuiSettingsHandler
     void*       (*ReadOpenFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, const char* name);              // Read: Called when entering into a new ini entry e.g. "[Window][Name]"
     void        (*ReadLineFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, void* entry, const char* line); // Read: Called for every line of text within an ini entry
     void        (*WriteAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);      // Write: Output every entries into 'out_buf'
+    void        (*ReadBinaryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, const char* data, const char* data_end); // Read: Called with the data written by WriteBinaryFn (optional)
+    void        (*WriteBinaryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImVector<char>* out_buf);    // Write: Output every entries into 'out_buf' in a compact binary form (optional, the WriteAllFn text is stored in binary files otherwise)
     void*       UserData;
+    bool        CacheOutput;    // Opt-in: the handler calls MarkIniSettingsDirty() whenever its data changes, so its last output can be reused until then. Other handlers are written on every save.
+    bool        Dirty;          // Set by MarkIniSettingsDirty(). Handlers with CacheOutput which are not dirty don't get their Write functions called again.
 
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
 
+// Last output of a settings handler (parallel to g.SettingsHandlers[])
+struct ImGuiSettingsHandlerCache
+{
+    ImGuiID             TypeHash;       // Handler this was written by
+    ImGuiTextBuffer     Text;
+    ImVector<char>      Binary;
+    bool                TextValid;
+    bool                BinaryValid;
+
+    ImGuiSettingsHandlerCache() { TypeHash = 0; TextValid = BinaryValid = false; }
+};
+
+// Asynchronous .ini save in flight (see io.IniSaveAsync). Allocated in a single block, followed by the data and the filenames.
+struct ImGuiSettingsSaveTask
+{
+    const char*         Filename;
+    const char*         TempFilename;   // Data is written there first then renamed over Filename, so a partial file is never observed
+    const void*         Data;
+    size_t              DataSize;
+    bool                Binary;
+    volatile long       State;          // ImGuiAsyncTaskState_
+};
+
 // Storage for current popup stack
 struct ImGuiPopupData
 {
@@ -823,10 +1001,11 @@ struct ImGuiColumnData
 {
     float               OffsetNorm;         // Column start offset, normalized 0.0 (far left) -> 1.0 (far right)
     float               OffsetNormBeforeResize;
+    float               Offset;             // Column start offset from the window, cached from OffsetNorm by BeginColumns() and SetColumnOffset()
     ImGuiColumnsFlags   Flags;              // Not exposed
     ImRect              ClipRect;
 
-    ImGuiColumnData()   { OffsetNorm = OffsetNormBeforeResize = 0.0f; Flags = ImGuiColumnsFlags_None; }
+    ImGuiColumnData()   { OffsetNorm = OffsetNormBeforeResize = Offset = 0.0f; Flags = ImGuiColumnsFlags_None; }
 };
 
 struct ImGuiColumns
@@ -983,6 +1162,110 @@ struct ImGuiPtrOrIndex
     ImGuiPtrOrIndex(int index)          { Ptr = NULL; Index = index; }
 };
 
+//-----------------------------------------------------------------------------
+// Clipper
+//-----------------------------------------------------------------------------
+
+// Item heights of a ImGuiListClipperVariable, with Fenwick trees (1-based) over them for O(log N) offset <-> index lookups.
+// Unknown heights count as the average of the measured ones, so the trees only hold measured heights and the number of measured items.
+struct ImGuiListClipperState
+{
+    ImGuiID             ID;
+    int                 LastFrameActive;
+    float               Width;                  // Content width the heights were measured at (wrapped items change height with it)
+    float               DefaultHeight;          // Estimated height until an item is measured
+    ImVector<float>     Heights;                // Measured height of each item, 0.0f if unknown
+    ImVector<float>     TreeHeights;
+    ImVector<int>       TreeKnown;
+    float               KnownHeight;            // Sum of measured heights
+    int                 KnownCount;             // Number of measured items
+
+    ImGuiListClipperState()         { ID = 0; LastFrameActive = -1; Width = DefaultHeight = 0.0f; KnownHeight = 0.0f; KnownCount = 0; }
+    float               GetEstimatedHeight() const { return KnownCount > 0 ? KnownHeight / KnownCount : DefaultHeight; }
+    IMGUI_API void      ClearHeights();
+    IMGUI_API void      Resize(int items_count);
+    IMGUI_API void      SetHeight(int idx, float height);
+    IMGUI_API float     GetOffset(int idx) const;           // Position of the top of item 'idx' from the top of the list
+    IMGUI_API int       FindIndex(float offset) const;      // Item at 'offset' from the top of the list (clamped to valid items)
+};
+
+// A visible row of a ImGuiTreeClipper
+struct ImGuiTreeClipperRow
+{
+    int                 NodeIdx;
+    int                 DescendantsCount;       // Number of nodes in its subtree, excluding itself
+    int                 ParentRow;              // -1 for root nodes
+    int                 Depth;
+    ImGuiID             ID;
+    bool                IsOpen;
+};
+
+// Flattened visible rows of a ImGuiTreeClipper
+struct ImGuiTreeClipperState
+{
+    ImGuiID             ID;
+    int                 LastFrameActive;
+    int                 NodesCount;             // Number of nodes the rows were built from, -1 to rebuild
+    ImVector<ImGuiTreeClipperRow> Rows;
+
+    ImGuiTreeClipperState()         { ID = 0; LastFrameActive = -1; NodesCount = -1; }
+};
+
+//-----------------------------------------------------------------------------
+// Data tables
+//-----------------------------------------------------------------------------
+
+// Sort key of an ImGuiDataTable, pointing to the values of its column (or to a copy of them)
+struct ImGuiDataTableSortKey
+{
+    ImGuiDataTableColumnType    Type;
+    bool                        Descending;
+    const void*                 Values;         // int or float values, or offsets into Strings
+    const char*                 Strings;
+};
+
+// Asynchronous sort of an ImGuiDataTable. Allocated in a single block, followed by the keys, the copies of their values and the output.
+struct ImGuiDataTableSortTask
+{
+    int                     Version;            // Table version being sorted
+    int                     RowsCount;
+    int                     KeysCount;
+    ImGuiDataTableSortKey*  Keys;
+    int*                    Rows;               // Output: row at each display position
+    int*                    RowsTemp;
+    volatile long           State;              // ImGuiAsyncTaskState_
+};
+
+//-----------------------------------------------------------------------------
+// Plots
+//-----------------------------------------------------------------------------
+
+// Decimated data of a plot using ImGuiPlotFlags_Decimate/ImGuiPlotFlags_DecimateLTTB
+struct ImGuiPlotState
+{
+    ImGuiID             ID;
+    int                 LastFrameActive;
+    const void*         SourceData;             // Source of the decimated data. With ImGuiPlotFlags_StaticData, values are assumed unchanged while all the Source/Values fields match.
+    float               (*SourceGetter)(void* data, int idx);
+    ImGuiDataType       SourceDataType;         // -1 when values come from a user getter
+    int                 SourceStride;
+    int                 ValuesCount;
+    int                 ValuesOffset;
+    int                 Columns;                // Number of pixel columns decimated to
+    ImGuiPlotFlags      Mode;                   // ImGuiPlotFlags_Decimate or ImGuiPlotFlags_DecimateLTTB
+    float               ValuesMin;              // Over all values, NaN ignored (FLT_MAX/-FLT_MAX if none)
+    float               ValuesMax;
+    ImVector<ImVec2>    Points;                 // Decimate: (min, max) for each column. DecimateLTTB: (index, value) of the selected values.
+
+    // Streams (see ImGuiPlotStream): a column covers SamplesPerColumn values aligned on their absolute number, Points[] is a ring indexed by absolute column number
+    int                 SamplesPerColumn;       // 0 if not a stream
+    ImS64               StreamCount;            // Stream Count when the columns were last updated
+    int                 StreamClearCount;       // Stream ClearCount when the columns were last updated
+    ImS64               StreamFirstColumn;      // Absolute number of the first displayed column
+
+    ImGuiPlotState()    { ID = 0; LastFrameActive = -1; SourceData = NULL; SourceGetter = NULL; SourceDataType = -1; SourceStride = 0; ValuesCount = ValuesOffset = Columns = -1; Mode = 0; ValuesMin = FLT_MAX; ValuesMax = -FLT_MAX; SamplesPerColumn = 0; StreamCount = StreamFirstColumn = 0; StreamClearCount = 0; }
+};
+
 //-----------------------------------------------------------------------------
 // Main Dear ImGui context
 //-----------------------------------------------------------------------------
@@ -1143,6 +1426,13 @@ struct ImGuiContext
     ImVector<ImGuiPtrOrIndex>       CurrentTabBarStack;
     ImVector<ImGuiShrinkWidthItem>  ShrinkWidthBuffer;
 
+    // Plots
+    ImPool<ImGuiPlotState>          Plots;
+
+    // Clippers
+    ImPool<ImGuiListClipperState>   ListClippers;               // Persistent state of ImGuiListClipperVariable
+    ImPool<ImGuiTreeClipperState>   TreeClippers;               // Persistent state of ImGuiTreeClipper
+
     // Widget state
     ImVec2                  LastValidMousePos;
     ImGuiInputTextState     InputTextState;
@@ -1168,8 +1458,14 @@ struct ImGuiContext
     bool                    SettingsLoaded;
     float                   SettingsDirtyTimer;                 // Save .ini Settings to memory when time reaches zero
     ImGuiTextBuffer         SettingsIniData;                    // In memory .ini settings
+    ImVector<char>          SettingsIniDataBinary;              // In memory .ini settings, binary format
     ImVector<ImGuiSettingsHandler>      SettingsHandlers;       // List of .ini settings handlers
+    ImVector<ImGuiSettingsHandlerCache> SettingsHandlersCache;  // Last output of each handler, reused while they are not dirty
     ImChunkStream<ImGuiWindowSettings>  SettingsWindows;        // ImGuiWindow .ini settings entries
+    ImGuiStorage                        SettingsWindowsById;    // Map window ID to offset into SettingsWindows[]
+    ImChunkStream<ImGuiDataTableSettings> SettingsDataTables;   // ImGuiDataTable .ini settings entries
+    ImGuiStorage                        SettingsDataTablesById; // Map data table ID to offset into SettingsDataTables[]
+    ImGuiSettingsSaveTask*              SettingsSaveTask;       // Asynchronous save in flight, NULL if none
 
     // Capture/Logging
     bool                    LogEnabled;
@@ -1194,6 +1490,9 @@ struct ImGuiContext
     int                     WantCaptureKeyboardNextFrame;
     int                     WantTextInputNextFrame;
     char                    TempBuffer[1024*3+1];               // Temporary text buffer
+    ImLinearArena           FrameArena;                         // Transient allocations, rewound by NewFrame() (see MemAllocFrame())
+    ImGuiCompactLevel       MemoryCompactRequest;               // CompactMemory() called within a frame, applied by the next NewFrame(). -1 if none.
+    float                   MemoryShrinkTimer;                  // Time since the last check for draw lists much larger than their high water mark
 
     ImGuiContext(ImFontAtlas* shared_font_atlas) : BackgroundDrawList(&DrawListSharedData), ForegroundDrawList(&DrawListSharedData)
     {
@@ -1305,6 +1604,7 @@ struct ImGuiContext
 
         SettingsLoaded = false;
         SettingsDirtyTimer = 0.0f;
+        SettingsSaveTask = NULL;
 
         LogEnabled = false;
         LogType = ImGuiLogType_None;
@@ -1322,6 +1622,8 @@ struct ImGuiContext
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
         memset(TempBuffer, 0, sizeof(TempBuffer));
+        MemoryCompactRequest = -1;
+        MemoryShrinkTimer = 0.0f;
     }
 };
 
@@ -1506,6 +1808,8 @@ struct IMGUI_API ImGuiWindow
     bool                    MemoryCompacted;
     int                     MemoryDrawListIdxCapacity;
     int                     MemoryDrawListVtxCapacity;
+    int                     MemoryDrawListIdxHighWater;         // Largest IdxBuffer.Size since the last draw list shrinking check
+    int                     MemoryDrawListVtxHighWater;
 
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
@@ -1570,8 +1874,10 @@ struct ImGuiTabItem
     float               Offset;                 // Position relative to beginning of tab
     float               Width;                  // Width currently displayed
     float               ContentWidth;           // Width of actual contents, stored during BeginTabItem() call
+    ImGuiID             NameHash;               // Hash of the label and font NameSize was measured with
+    ImVec2              NameSize;               // Size of the label, only measured again when NameHash changes
 
-    ImGuiTabItem()      { ID = 0; Flags = ImGuiTabItemFlags_None; LastFrameVisible = LastFrameSelected = -1; NameOffset = -1; Offset = Width = ContentWidth = 0.0f; }
+    ImGuiTabItem()      { ID = 0; Flags = ImGuiTabItemFlags_None; LastFrameVisible = LastFrameSelected = -1; NameOffset = -1; Offset = Width = ContentWidth = 0.0f; NameHash = 0; NameSize = ImVec2(0.0f, 0.0f); }
 };
 
 // Storage for a tab bar (sizeof() 92~96 bytes)
@@ -1597,9 +1903,16 @@ struct ImGuiTabBar
     ImGuiID             ReorderRequestTabId;
     ImS8                ReorderRequestDir;
     bool                WantLayout;
+    bool                WantLayoutWidths;       // Set when tabs are added, removed, reordered or resized. Otherwise TabBarLayout() keeps the widths and offsets of the previous frame.
+    bool                TabsIndexDirty;         // Set when tabs are removed or reordered. TabsIndex will be rebuilt on the next lookup.
     bool                VisibleTabWasSubmitted;
     short               LastTabItemIdx;         // For BeginTabItem()/EndTabItem()
     ImVec2              FramePadding;           // style.FramePadding locked at the time of BeginTabBar()
+    ImGuiID             LayoutFontId;           // Font used by the last TabBarLayout(), name sizes are measured again when it changes
+    float               LayoutWidthAvail;       // Available width used by the last TabBarLayout()
+    float               LayoutSpacing;          // style.ItemInnerSpacing.x used by the last TabBarLayout()
+    ImGuiTabBarFlags    LayoutFlags;            // Fitting policy used by the last TabBarLayout()
+    ImGuiStorage        TabsIndex;              // Tab ID -> index + 1 into Tabs[], for TabBarFindTabByID()
     ImGuiTextBuffer     TabsNames;              // For non-docking tab bar we re-append names in a contiguous buffer.
 
     ImGuiTabBar();
@@ -1648,6 +1961,10 @@ namespace ImGui
     inline ImFont*          GetDefaultFont() { ImGuiContext& g = *GImGui; return g.IO.FontDefault ? g.IO.FontDefault : g.IO.Fonts->Fonts[0]; }
     inline ImDrawList*      GetForegroundDrawList(ImGuiWindow* window) { IM_UNUSED(window); ImGuiContext& g = *GImGui; return &g.ForegroundDrawList; } // This seemingly unnecessary wrapper simplifies compatibility between the 'master' and 'docking' branches.
 
+    // Transient allocations: the memory is only valid until the next NewFrame(), MemFreeFrame() is a no-op unless IMGUI_DISABLE_FRAME_ARENA is defined
+    IMGUI_API void*         MemAllocFrame(size_t size);
+    IMGUI_API void          MemFreeFrame(void* ptr);
+
     // Init
     IMGUI_API void          Initialize(ImGuiContext* context);
     IMGUI_API void          Shutdown(ImGuiContext* context);    // Since 1.60 this is a _private_ function. You can call DestroyContext() to destroy the context created by CreateContext().
@@ -1661,9 +1978,12 @@ namespace ImGui
     // Settings
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API void                  MarkIniSettingsDirty(ImGuiWindow* window);
+    IMGUI_API void                  MarkIniSettingsDirty(ImGuiSettingsHandler* handler);
     IMGUI_API ImGuiWindowSettings*  CreateNewWindowSettings(const char* name);
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
     IMGUI_API ImGuiWindowSettings*  FindOrCreateWindowSettings(const char* name);
+    IMGUI_API ImGuiDataTableSettings* CreateDataTableSettings(ImGuiID id, int columns_count);
+    IMGUI_API ImGuiDataTableSettings* FindDataTableSettings(ImGuiID id);
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(const char* type_name);
 
     // Scrolling
@@ -1772,6 +2092,7 @@ namespace ImGui
     IMGUI_API void          TabBarQueueChangeTabOrder(ImGuiTabBar* tab_bar, const ImGuiTabItem* tab, int dir);
     IMGUI_API bool          TabItemEx(ImGuiTabBar* tab_bar, const char* label, bool* p_open, ImGuiTabItemFlags flags);
     IMGUI_API ImVec2        TabItemCalcSize(const char* label, bool has_close_button);
+    IMGUI_API ImVec2        TabItemCalcSize(const ImVec2& label_size, bool has_close_button);
     IMGUI_API void          TabItemBackground(ImDrawList* draw_list, const ImRect& bb, ImGuiTabItemFlags flags, ImU32 col);
     IMGUI_API bool          TabItemLabelAndCloseButton(ImDrawList* draw_list, const ImRect& bb, ImGuiTabItemFlags flags, ImVec2 frame_padding, const char* label, ImGuiID tab_id, ImGuiID close_button_id);
 
@@ -1850,7 +2171,7 @@ namespace ImGui
     IMGUI_API void          ColorPickerOptionsPopup(const float* ref_col, ImGuiColorEditFlags flags);
 
     // Plot
-    IMGUI_API void          PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 frame_size);
+    IMGUI_API void          PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 frame_size, ImGuiPlotFlags flags = 0);
 
     // Shade functions (write over already created vertices)
     IMGUI_API void          ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1);
@@ -1859,6 +2180,8 @@ namespace ImGui
     // Garbage collection
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
     IMGUI_API void          GcAwakeTransientWindowBuffers(ImGuiWindow* window);
+    IMGUI_API void          GcShrinkDrawList(ImDrawList* draw_list, int idx_capacity, int vtx_capacity);
+    IMGUI_API void          GcCompactMemory(ImGuiCompactLevel level);
 
     // Debug Tools
     inline void             DebugDrawItemRect(ImU32 col = IM_COL32(255,0,0,255))    { ImGuiContext& g = *GImGui; ImGuiWindow* window = g.CurrentWindow; GetForegroundDrawList(window)->AddRect(window->DC.LastItemRect.Min, window->DC.LastItemRect.Max, col); }
@@ -1871,7 +2194,9 @@ IMGUI_API bool              ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent);
 IMGUI_API void              ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
+IMGUI_API void              ImFontAtlasBuildSelectTexWidth(ImFontAtlas* atlas, void* stbrp_rects_opaque, int rects_count, int tex_height_max, int pack_inset, int pack_heuristic);
 IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasBuildParallelFor(ImFontAtlas* atlas, int tasks_count, void (*task_func)(void* task_data, int task_index), void* task_data);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
@@ -25,6 +25,7 @@ Index of this file:
 // [SECTION] Widgets: BeginTabBar, EndTabBar, etc.
 // [SECTION] Widgets: BeginTabItem, EndTabItem, etc.
 // [SECTION] Widgets: Columns, BeginColumns, EndColumns, etc.
+// [SECTION] Widgets: ImGuiDataTable
 
 */
 
@@ -46,6 +47,10 @@ Index of this file:
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#if (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_SSE
+#include <emmintrin.h>  // _mm_min_ps, _mm_max_ps
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -3207,22 +3212,50 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)
 #define STB_TEXTEDIT_MOVEWORDLEFT   STB_TEXTEDIT_MOVEWORDLEFT_IMPL    // They need to be #define for stb_textedit.h
 #define STB_TEXTEDIT_MOVEWORDRIGHT  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL
 
-static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
+// We don't do word-wrapping so rows are lines, which lets stb_textedit find the row under the mouse or cursor from our line index
+static void STB_TEXTEDIT_FINDROW_AT_Y_IMPL(STB_TEXTEDIT_STRING* obj, float y, int* out_row_start, float* out_row_y)
+{
+    const float line_height = GImGui->FontSize;
+    const int line = ImClamp((int)(y / line_height), 0, obj->LineStarts.Size - 1);
+    *out_row_start = obj->LineStarts[line];
+    *out_row_y = line * line_height;
+}
+static void STB_TEXTEDIT_FINDROW_AT_CHAR_IMPL(STB_TEXTEDIT_STRING* obj, int idx, int* out_row_start, int* out_prev_row_start, float* out_row_y)
+{
+    const int line = obj->LineIndexFindLine(idx);
+    *out_row_start = obj->LineStarts[line];
+    *out_prev_row_start = obj->LineStarts[ImMax(line - 1, 0)];
+    *out_row_y = line * GImGui->FontSize;
+}
+#define STB_TEXTEDIT_FINDROW_AT_Y       STB_TEXTEDIT_FINDROW_AT_Y_IMPL
+#define STB_TEXTEDIT_FINDROW_AT_CHAR    STB_TEXTEDIT_FINDROW_AT_CHAR_IMPL
+
+// Edit the text without recording undo history, see STB_TEXTEDIT_DELETECHARS()/STB_TEXTEDIT_INSERTCHARS() below
+static void DeleteCharsNoUndo(STB_TEXTEDIT_STRING* obj, int pos, int n)
 {
     ImWchar* dst = obj->TextW.Data + pos;
 
-    // We maintain our buffer length in both UTF-8 and wchar formats
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+    // We maintain our buffer length in both UTF-8 and wchar formats, and once valid the UTF-8 buffer itself (so it never needs a full conversion)
+    const int bytes_count = ImTextCountUtf8BytesFromStr(dst, dst + n);
+    if (obj->TextAIsValid)
+    {
+        char* dst_a = obj->TextA.Data + obj->GetUtf8Offset(pos);
+        memmove(dst_a, dst_a + bytes_count, (size_t)(obj->TextA.Data + obj->CurLenA - (dst_a + bytes_count)) + 1);
+    }
+    else if (obj->OffsetCacheW > pos)
+    {
+        obj->InvalidateOffsetCache();
+    }
+    obj->LineIndexOnDelete(pos, n);
+    obj->TextEdited = true;
+    obj->CurLenA -= bytes_count;
     obj->CurLenW -= n;
 
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const ImWchar* src = obj->TextW.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    // Offset remaining text
+    memmove(dst, dst + n, (size_t)(obj->CurLenW - pos + 1) * sizeof(ImWchar));
 }
 
-static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
+static bool InsertCharsNoUndo(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
 {
     const bool is_resizable = (obj->UserFlags & ImGuiInputTextFlags_CallbackResize) != 0;
     const int text_len = obj->CurLenW;
@@ -3232,6 +3265,11 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
     if (!is_resizable && (new_text_len_utf8 + obj->CurLenA + 1 > obj->BufCapacityA))
         return false;
 
+    // Locate insertion point in the UTF-8 buffer before modifying TextW, which GetUtf8Offset() reads
+    const int pos_a = obj->TextAIsValid ? obj->GetUtf8Offset(pos) : 0;
+    if (!obj->TextAIsValid && obj->OffsetCacheW > pos)
+        obj->InvalidateOffsetCache();
+
     // Grow internal buffer if needed
     if (new_text_len + text_len + 1 > obj->TextW.Size)
     {
@@ -3246,6 +3284,21 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
     memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
 
+    if (obj->TextAIsValid)
+    {
+        if (obj->CurLenA + new_text_len_utf8 + 1 > obj->TextA.Size)
+            obj->TextA.resize(obj->CurLenA + ImClamp(new_text_len_utf8 * 4, 32, ImMax(256, new_text_len_utf8)) + 1);
+        char* text_a = obj->TextA.Data;
+        if (pos_a != obj->CurLenA)
+            memmove(text_a + pos_a + new_text_len_utf8, text_a + pos_a, (size_t)(obj->CurLenA - pos_a));
+        const char text_a_next = text_a[pos_a + new_text_len_utf8]; // ImTextStrToUtf8() writes a zero-terminator
+        ImTextStrToUtf8(text_a + pos_a, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+        text_a[pos_a + new_text_len_utf8] = text_a_next;
+        text_a[obj->CurLenA + new_text_len_utf8] = '\0';
+    }
+
+    obj->LineIndexOnInsert(pos, new_text, new_text_len);
+    obj->TextEdited = true;
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->TextW[obj->CurLenW] = '\0';
@@ -3253,6 +3306,20 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
     return true;
 }
 
+static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
+{
+    obj->UndoRecordDelete(pos, n);
+    DeleteCharsNoUndo(obj, pos, n);
+}
+
+static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
+{
+    if (!InsertCharsNoUndo(obj, pos, new_text, new_text_len))
+        return false;
+    obj->UndoRecordInsert(pos, new_text_len);
+    return true;
+}
+
 // We don't use an enum so we can build even with conflicting symbols (if another user of stb_textedit.h leak their STB_TEXTEDIT_K_* symbols)
 #define STB_TEXTEDIT_K_LEFT         0x200000 // keyboard input to move cursor left
 #define STB_TEXTEDIT_K_RIGHT        0x200001 // keyboard input to move cursor right
@@ -3273,11 +3340,10 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
 #define STB_TEXTEDIT_IMPLEMENTATION
 #include "imstb_textedit.h"
 
-// stb_textedit internally allows for a single undo record to do addition and deletion, but somehow, calling 
-// the stb_textedit_paste() function creates two separate records, so we perform it manually. (FIXME: Report to nothings/stb?) 
+// Replace the whole text. The deletion and insertion are merged into a single undo record by ImGuiInputTextState::UndoRecordInsert().
 static void stb_textedit_replace(STB_TEXTEDIT_STRING* str, STB_TexteditState* state, const STB_TEXTEDIT_CHARTYPE* text, int text_len)
 {
-    stb_text_makeundo_replace(str, state, 0, str->CurLenW, text_len);
+    str->UndoMergeAllowed = false;
     ImStb::STB_TEXTEDIT_DELETECHARS(str, 0, str->CurLenW);
     if (text_len <= 0)
         return;
@@ -3294,11 +3360,418 @@ static void stb_textedit_replace(STB_TEXTEDIT_STRING* str, STB_TexteditState* st
 
 void ImGuiInputTextState::OnKeyPressed(int key)
 {
-    stb_textedit_key(this, &Stb, key);
+    // Undo/redo are handled on our side (see UndoRecordDelete()), and keys other than text input and deletion break undo records
+    const int key_no_shift = key & ~STB_TEXTEDIT_K_SHIFT;
+    if (key_no_shift == STB_TEXTEDIT_K_UNDO)
+        Undo();
+    else if (key_no_shift == STB_TEXTEDIT_K_REDO)
+        Redo();
+    else
+    {
+        if (key_no_shift >= 0x200000 && key_no_shift != STB_TEXTEDIT_K_BACKSPACE && key_no_shift != STB_TEXTEDIT_K_DELETE)
+            UndoMergeAllowed = false;
+        stb_textedit_key(this, &Stb, key);
+    }
     CursorFollow = true;
     CursorAnimReset();
 }
 
+// Edits and cursor queries are mostly local, so we scan from the last converted position instead of from the start of the text.
+int ImGuiInputTextState::GetUtf8Offset(int pos_w)
+{
+    IM_ASSERT(pos_w >= 0 && pos_w <= CurLenW && OffsetCacheW <= CurLenW);
+    const ImWchar* text = TextW.Data;
+    if (pos_w >= OffsetCacheW)
+        OffsetCacheA += ImTextCountUtf8BytesFromStr(text + OffsetCacheW, text + pos_w);
+    else if (pos_w >= OffsetCacheW / 2)
+        OffsetCacheA -= ImTextCountUtf8BytesFromStr(text + pos_w, text + OffsetCacheW);
+    else
+        OffsetCacheA = ImTextCountUtf8BytesFromStr(text, text + pos_w);
+    OffsetCacheW = pos_w;
+    return OffsetCacheA;
+}
+
+void ImGuiInputTextState::LineIndexRebuild()
+{
+    LineStarts.resize(0);
+    LineStarts.push_back(0);
+    for (int n = 0; n < CurLenW; n++)
+        if (TextW.Data[n] == '\n')
+            LineStarts.push_back(n + 1);
+}
+
+int ImGuiInputTextState::LineIndexFindLine(int pos_w) const
+{
+    // Binary search for the last line starting at or before 'pos_w'
+    IM_ASSERT(LineStarts.Size > 0 && LineStarts[0] == 0);
+    int line_min = 0, line_max = LineStarts.Size - 1;
+    while (line_min < line_max)
+    {
+        const int line_mid = (line_min + line_max + 1) >> 1;
+        if (LineStarts.Data[line_mid] <= pos_w)
+            line_min = line_mid;
+        else
+            line_max = line_mid - 1;
+    }
+    return line_min;
+}
+
+void ImGuiInputTextState::LineIndexOnInsert(int pos_w, const ImWchar* text, int text_len)
+{
+    int new_lines_count = 0;
+    for (int n = 0; n < text_len; n++)
+        if (text[n] == '\n')
+            new_lines_count++;
+
+    // Offset lines after the insertion point, then add the new ones in-between
+    const int line = LineIndexFindLine(pos_w);
+    const int old_lines_count = LineStarts.Size;
+    LineStarts.resize(old_lines_count + new_lines_count);
+    int* line_starts = LineStarts.Data;
+    for (int n = old_lines_count - 1; n > line; n--)
+        line_starts[n + new_lines_count] = line_starts[n] + text_len;
+    for (int n = 0, dst_line = line + 1; n < text_len; n++)
+        if (text[n] == '\n')
+            line_starts[dst_line++] = pos_w + n + 1;
+}
+
+void ImGuiInputTextState::LineIndexOnDelete(int pos_w, int n)
+{
+    // Remove lines starting within the deleted range (their '\n' is being deleted), then offset following lines
+    const int line = LineIndexFindLine(pos_w);
+    int* line_starts = LineStarts.Data;
+    int line_end = line + 1;
+    while (line_end < LineStarts.Size && line_starts[line_end] <= pos_w + n)
+        line_end++;
+    const int removed_lines_count = line_end - (line + 1);
+    for (int dst_line = line + 1; line_end < LineStarts.Size; line_end++, dst_line++)
+        line_starts[dst_line] = line_starts[line_end] - n;
+    LineStarts.resize(LineStarts.Size - removed_lines_count);
+}
+
+// Spans of stored undo text larger than this get compressed (when io.ConfigInputTextUndoCompress is set)
+static const int INPUTTEXT_UNDO_COMPRESS_MIN_SIZE = 1024;
+
+// Minimal LZ77 compression of the text stored in the undo history. Text typically compresses 2-3x, which is plenty for our purpose.
+// The stream is made of chunks: token 0x00..0x7F copies (token+1) literal bytes which follow, token 0x80..0xFF copies ((token&0x7F)+4) bytes
+// from the 16-bit little-endian backward offset which follows. 'dst' needs room for src_size + src_size/128 + 1 bytes. Returns the compressed size.
+static int InputTextUndoCompress(char* dst, const char* src, int src_size)
+{
+    const int HASH_BITS = 12;
+    int hash_table[1 << HASH_BITS];
+    for (int n = 0; n < IM_ARRAYSIZE(hash_table); n++)
+        hash_table[n] = -1;
+
+    const unsigned char* s = (const unsigned char*)src;
+    unsigned char* d = (unsigned char*)dst;
+    int pos = 0, literal_start = 0;
+    while (pos <= src_size)
+    {
+        int match_pos = -1, match_len = 0;
+        if (pos + 4 <= src_size)
+        {
+            const ImU32 seq = (ImU32)s[pos] | ((ImU32)s[pos + 1] << 8) | ((ImU32)s[pos + 2] << 16) | ((ImU32)s[pos + 3] << 24);
+            const int hash = (int)((seq * 2654435761u) >> (32 - HASH_BITS));
+            match_pos = hash_table[hash];
+            hash_table[hash] = pos;
+            if (match_pos >= 0 && pos - match_pos <= 0xFFFF && memcmp(s + match_pos, s + pos, 4) == 0)
+                for (match_len = 4; match_len < 0x7F + 4 && pos + match_len < src_size && s[match_pos + match_len] == s[pos + match_len]; )
+                    match_len++;
+        }
+        if (match_len == 0 && pos < src_size)
+        {
+            pos++;
+            continue;
+        }
+
+        // Flush pending literals, then the match
+        while (literal_start < pos)
+        {
+            const int literal_len = ImMin(pos - literal_start, 0x80);
+            *d++ = (unsigned char)(literal_len - 1);
+            memcpy(d, s + literal_start, (size_t)literal_len);
+            d += literal_len;
+            literal_start += literal_len;
+        }
+        if (match_len == 0)
+            break;
+        const int match_offset = pos - match_pos;
+        *d++ = (unsigned char)(0x80 | (match_len - 4));
+        *d++ = (unsigned char)(match_offset & 0xFF);
+        *d++ = (unsigned char)(match_offset >> 8);
+        pos += match_len;
+        literal_start = pos;
+    }
+    return (int)(d - (unsigned char*)dst);
+}
+
+static void InputTextUndoDecompress(char* dst, int dst_size, const char* src, int src_size)
+{
+    const unsigned char* s = (const unsigned char*)src;
+    const unsigned char* s_end = s + src_size;
+    char* d = dst;
+    while (s < s_end)
+    {
+        const int token = *s++;
+        if (token < 0x80)
+        {
+            memcpy(d, s, (size_t)token + 1);
+            d += token + 1;
+            s += token + 1;
+        }
+        else
+        {
+            const char* match = d - (s[0] | (s[1] << 8));
+            s += 2;
+            for (int n = (token & 0x7F) + 4; n > 0; n--) // Byte per byte as the match may overlap the output
+                *d++ = *match++;
+        }
+    }
+    IM_ASSERT(d == dst + dst_size);
+    IM_UNUSED(dst_size);
+}
+
+static void InputTextUndoReverseBytes(char* p, char* p_end)
+{
+    for (p_end--; p < p_end; p++, p_end--)
+        ImSwap(*p, *p_end);
+}
+
+// Add text to the last record of a stack, after or before the text it already stores
+static void InputTextUndoStoreText(ImGuiInputTextUndoStack* stack, ImGuiInputTextUndoRecord* rec, const ImWchar* text, int text_len, bool prepend)
+{
+    IM_ASSERT(rec == &stack->Records.back() && !rec->Compressed && rec->TextOffset + rec->TextSize == stack->Text.Size);
+    const int bytes_count = ImTextCountUtf8BytesFromStr(text, text + text_len);
+    const int prev_size = stack->Text.Size;
+    stack->Text.resize(prev_size + bytes_count + 1); // ImTextStrToUtf8() writes a zero-terminator
+    ImTextStrToUtf8(stack->Text.Data + prev_size, bytes_count + 1, text, text + text_len);
+    stack->Text.pop_back();
+    if (prepend && rec->TextSize > 0)
+    {
+        // Rotate the new text in front of the previous one: reverse both parts, then the whole
+        char* p = stack->Text.Data + rec->TextOffset;
+        InputTextUndoReverseBytes(p, p + rec->TextSize);
+        InputTextUndoReverseBytes(p + rec->TextSize, p + rec->TextSize + bytes_count);
+        InputTextUndoReverseBytes(p, p + rec->TextSize + bytes_count);
+    }
+    rec->TextSize += bytes_count;
+    rec->TextSizeA += bytes_count;
+}
+
+// Compress the text of the last record of a stack if it is large enough. We don't add text to a compressed record afterward.
+static void InputTextUndoCompressText(ImGuiInputTextUndoStack* stack, ImGuiInputTextUndoRecord* rec)
+{
+    IM_ASSERT(rec == &stack->Records.back() && !rec->Compressed);
+    if (!GImGui->IO.ConfigInputTextUndoCompress || rec->TextSize < INPUTTEXT_UNDO_COMPRESS_MIN_SIZE)
+        return;
+    char* compressed = (char*)IM_ALLOC((size_t)(rec->TextSize + rec->TextSize / 128 + 1));
+    const int compressed_size = InputTextUndoCompress(compressed, stack->Text.Data + rec->TextOffset, rec->TextSize);
+    if (compressed_size < rec->TextSize)
+    {
+        memcpy(stack->Text.Data + rec->TextOffset, compressed, (size_t)compressed_size);
+        stack->Text.resize(rec->TextOffset + compressed_size);
+        rec->TextSize = compressed_size;
+        rec->Compressed = true;
+    }
+    IM_FREE(compressed);
+}
+
+static ImGuiInputTextUndoRecord* InputTextUndoPushRecord(ImGuiInputTextUndoStack* stack, int where, int deleted_len, int inserted_len)
+{
+    ImGuiInputTextUndoRecord rec;
+    rec.Where = where;
+    rec.DeletedLen = deleted_len;
+    rec.InsertedLen = inserted_len;
+    rec.TextOffset = stack->Text.Size;
+    rec.TextSize = rec.TextSizeA = 0;
+    rec.Compressed = false;
+    stack->Records.push_back(rec);
+    return &stack->Records.back();
+}
+
+// Discard records from the bottom of a stack until we fit in the budget
+static void InputTextUndoDiscardOldest(ImGuiInputTextUndoStack* stack, int* memory_usage, int memory_budget)
+{
+    int discard_count = 0;
+    while (*memory_usage > memory_budget && discard_count < stack->Records.Size)
+        *memory_usage -= (int)sizeof(ImGuiInputTextUndoRecord) + stack->Records[discard_count++].TextSize;
+    if (discard_count == 0)
+        return;
+    const int discard_text_size = (discard_count < stack->Records.Size) ? stack->Records[discard_count].TextOffset : stack->Text.Size;
+    stack->Records.erase(stack->Records.Data, stack->Records.Data + discard_count);
+    if (discard_text_size > 0)
+        stack->Text.erase(stack->Text.Data, stack->Text.Data + discard_text_size);
+    for (int n = 0; n < stack->Records.Size; n++)
+        stack->Records[n].TextOffset -= discard_text_size;
+}
+
+// Edits are coalesced into the last undo record when they extend it: typing (until a new word starts), erasing what was just typed,
+// repeated Backspace or Delete, typing over a selection. Any other edit, or an explicit break (UndoMergeAllowed == false), starts a new record.
+void ImGuiInputTextState::UndoRecordDelete(int pos_w, int n)
+{
+    ImGuiContext& g = *GImGui;
+    if (n <= 0 || (UserFlags & ImGuiInputTextFlags_NoUndoRedo) || g.IO.ConfigInputTextUndoMemoryBudget <= 0)
+        return;
+    RedoStack.clear();
+
+    const ImWchar* text = TextW.Data + pos_w;
+    ImGuiInputTextUndoRecord* rec = (UndoMergeAllowed && UndoStack.Records.Size > 0) ? &UndoStack.Records.back() : NULL;
+    if (rec && pos_w >= rec->Where && pos_w + n == rec->Where + rec->InsertedLen)
+    {
+        // Erasing the end of the text inserted by the record
+        rec->InsertedLen -= n;
+        if (rec->InsertedLen == 0 && rec->DeletedLen == 0)
+            UndoStack.Records.pop_back();
+        return;
+    }
+    if (rec && !rec->Compressed && pos_w == rec->Where + rec->InsertedLen)
+    {
+        // Deleting forward from the end of the record
+        InputTextUndoStoreText(&UndoStack, rec, text, n, false);
+        rec->DeletedLen += n;
+    }
+    else if (rec && !rec->Compressed && rec->InsertedLen == 0 && pos_w + n == rec->Where)
+    {
+        // Deleting backward from the start of the record
+        InputTextUndoStoreText(&UndoStack, rec, text, n, true);
+        rec->Where = pos_w;
+        rec->DeletedLen += n;
+    }
+    else
+    {
+        rec = InputTextUndoPushRecord(&UndoStack, pos_w, n, 0);
+        InputTextUndoStoreText(&UndoStack, rec, text, n, false);
+        InputTextUndoCompressText(&UndoStack, rec);
+        UndoMergeAllowed = true;
+    }
+    UndoTrim();
+}
+
+void ImGuiInputTextState::UndoRecordInsert(int pos_w, int n)
+{
+    ImGuiContext& g = *GImGui;
+    if (n <= 0 || (UserFlags & ImGuiInputTextFlags_NoUndoRedo) || g.IO.ConfigInputTextUndoMemoryBudget <= 0)
+        return;
+    RedoStack.clear();
+
+    ImGuiInputTextUndoRecord* rec = (UndoMergeAllowed && UndoStack.Records.Size > 0) ? &UndoStack.Records.back() : NULL;
+    if (rec && pos_w == rec->Where + rec->InsertedLen && !(n == 1 && rec->InsertedLen > 0 && ImStb::is_word_boundary_from_right(this, pos_w)))
+    {
+        rec->InsertedLen += n;
+        return;
+    }
+    InputTextUndoPushRecord(&UndoStack, pos_w, 0, n);
+    UndoMergeAllowed = true;
+    UndoTrim();
+}
+
+void ImGuiInputTextState::UndoTrim()
+{
+    // Discard the oldest undo records first, then the furthest redo records
+    ImGuiContext& g = *GImGui;
+    const int memory_budget = g.IO.ConfigInputTextUndoMemoryBudget;
+    int memory_usage = UndoStack.GetMemoryUsage() + RedoStack.GetMemoryUsage();
+    if (memory_usage <= memory_budget)
+        return;
+    InputTextUndoDiscardOldest(&UndoStack, &memory_usage, memory_budget);
+    InputTextUndoDiscardOldest(&RedoStack, &memory_usage, memory_budget);
+    if (UndoStack.Records.Size == 0)
+        UndoMergeAllowed = false;
+}
+
+// Apply the last record of 'src' and move it to 'dst', storing the text it removes so it can be applied back.
+// Undo records store the text deleted by the edit, redo records store the text it inserted.
+static bool InputTextUndoApply(ImGuiInputTextState* state, ImGuiInputTextUndoStack* src, ImGuiInputTextUndoStack* dst, bool is_redo)
+{
+    state->UndoMergeAllowed = false;
+    if (src->Records.Size == 0)
+        return false;
+
+    const ImGuiInputTextUndoRecord rec = src->Records.back();
+    const int remove_len = is_redo ? rec.DeletedLen : rec.InsertedLen;
+    const int restore_len = is_redo ? rec.InsertedLen : rec.DeletedLen;
+    const bool is_resizable = (state->UserFlags & ImGuiInputTextFlags_CallbackResize) != 0;
+    const int remove_len_a = (rec.Where + remove_len <= state->CurLenW) ? ImTextCountUtf8BytesFromStr(state->TextW.Data + rec.Where, state->TextW.Data + rec.Where + remove_len) : 0;
+    if (rec.Where + remove_len > state->CurLenW || (!is_resizable && state->CurLenA - remove_len_a + rec.TextSizeA + 1 > state->BufCapacityA))
+    {
+        // History doesn't match the buffer anymore (e.g. it was modified while we were inactive), or the result doesn't fit
+        state->UndoClear();
+        return false;
+    }
+
+    // Decode the text to restore
+    ImWchar* restore_text = NULL;
+    if (restore_len > 0)
+    {
+        const char* text_a = src->Text.Data + rec.TextOffset;
+        char* decompressed = NULL;
+        if (rec.Compressed)
+        {
+            decompressed = (char*)ImGui::MemAllocFrame((size_t)rec.TextSizeA);
+            InputTextUndoDecompress(decompressed, rec.TextSizeA, text_a, rec.TextSize);
+            text_a = decompressed;
+        }
+        restore_text = (ImWchar*)ImGui::MemAllocFrame((size_t)(restore_len + 1) * sizeof(ImWchar));
+        const int restore_text_len = ImTextStrFromUtf8(restore_text, restore_len + 1, text_a, text_a + rec.TextSizeA);
+        IM_ASSERT(restore_text_len == restore_len);
+        IM_UNUSED(restore_text_len);
+        ImGui::MemFreeFrame(decompressed);
+    }
+    src->Text.resize(rec.TextOffset);
+    src->Records.pop_back();
+
+    // Move the record to the other stack along with the text we are about to remove
+    ImGuiInputTextUndoRecord* dst_rec = InputTextUndoPushRecord(dst, rec.Where, rec.DeletedLen, rec.InsertedLen);
+    if (remove_len > 0)
+    {
+        InputTextUndoStoreText(dst, dst_rec, state->TextW.Data + rec.Where, remove_len, false);
+        InputTextUndoCompressText(dst, dst_rec);
+        ImStb::DeleteCharsNoUndo(state, rec.Where, remove_len);
+    }
+    if (restore_len > 0)
+    {
+        bool inserted = ImStb::InsertCharsNoUndo(state, rec.Where, restore_text, restore_len);
+        IM_ASSERT(inserted);
+        IM_UNUSED(inserted);
+        ImGui::MemFreeFrame(restore_text);
+    }
+    state->Stb.cursor = rec.Where + restore_len;
+    state->Stb.has_preferred_x = 0;
+    state->ClearSelection();
+    state->UndoTrim();
+    return true;
+}
+
+bool ImGuiInputTextState::Undo()
+{
+    return InputTextUndoApply(this, &UndoStack, &RedoStack, false);
+}
+
+bool ImGuiInputTextState::Redo()
+{
+    return InputTextUndoApply(this, &RedoStack, &UndoStack, true);
+}
+
+// Record an edit made by the user from a callback (ImGuiInputTextCallbackData::BufDirty), as a replacement of the range which changed
+static void InputTextUndoRecordUserEdit(ImGuiInputTextState* state, const char* new_text, const char* new_text_end)
+{
+    const int new_text_w_size = (int)(new_text_end - new_text) + 1;
+    ImWchar* new_text_w = (ImWchar*)ImGui::MemAllocFrame((size_t)new_text_w_size * sizeof(ImWchar));
+    const int new_len = ImTextStrFromUtf8(new_text_w, new_text_w_size, new_text, new_text_end);
+    const ImWchar* old_text_w = state->TextW.Data;
+    const int old_len = state->CurLenW;
+    int prefix_len = 0, suffix_len = 0;
+    while (prefix_len < old_len && prefix_len < new_len && old_text_w[prefix_len] == new_text_w[prefix_len])
+        prefix_len++;
+    while (suffix_len < old_len - prefix_len && suffix_len < new_len - prefix_len && old_text_w[old_len - 1 - suffix_len] == new_text_w[new_len - 1 - suffix_len])
+        suffix_len++;
+    state->UndoMergeAllowed = false;
+    state->UndoRecordDelete(prefix_len, old_len - prefix_len - suffix_len);
+    state->UndoRecordInsert(prefix_len, new_len - prefix_len - suffix_len);
+    state->UndoMergeAllowed = false;
+    ImGui::MemFreeFrame(new_text_w);
+}
+
 ImGuiInputTextCallbackData::ImGuiInputTextCallbackData()
 {
     memset(this, 0, sizeof(*this));
@@ -3340,7 +3813,7 @@ void ImGuiInputTextCallbackData::InsertChars(int pos, const char* new_text, cons
         IM_ASSERT(edit_state->ID != 0 && g.ActiveId == edit_state->ID);
         IM_ASSERT(Buf == edit_state->TextA.Data);
         int new_buf_size = BufTextLen + ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)) + 1;
-        edit_state->TextA.reserve(new_buf_size + 1);
+        edit_state->TextA.resize(new_buf_size + 1);
         Buf = edit_state->TextA.Data;
         BufSize = edit_state->BufCapacityA = new_buf_size;
     }
@@ -3437,6 +3910,7 @@ static bool InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags f
 //  doing UTF8 > U16 > UTF8 conversions on the go to easily interface with stb_textedit. Ideally should stay in UTF-8 all the time. See https://github.com/nothings/stb/issues/188)
 bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* callback_user_data)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_InputText);
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return false;
@@ -3542,8 +4016,11 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextW.resize(buf_size + 1);          // wchar count <= UTF-8 count. we use +1 to make sure that .Data is always pointing to at least an empty string.
         state->TextA.resize(0);
         state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
+        state->TextEdited = false;
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        state->InvalidateOffsetCache();
+        state->LineIndexRebuild();
 
         // Preserve cursor position and undo/redo stack if we come back to same widget
         // FIXME: For non-readonly widgets we might be able to require that TextAIsValid && TextA == buf ? (untested) and discard undo stack if user buffer has changed.
@@ -3553,12 +4030,14 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             // Recycle existing cursor/selection/undo stack but clamp position
             // Note a single mouse click will override the cursor/position immediately by calling stb_textedit_click handler.
             state->CursorClamp();
+            state->UndoMergeAllowed = false;
         }
         else
         {
             state->ID = id;
             state->ScrollX = 0.0f;
             stb_textedit_initialize_state(&state->Stb, !is_multiline);
+            state->UndoClear();
             if (!is_multiline && focus_requested_by_code)
                 select_all = true;
         }
@@ -3603,14 +4082,23 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     bool enter_pressed = false;
 
     // When read-only we always use the live data passed to the function
-    // FIXME-OPT: Because our selection/cursor code currently needs the wide text we need to convert it when active, which is not ideal :(
+    // Because our selection/cursor code currently needs the wide text we need to convert it when active. We keep a copy of the buffer
+    // we converted in TextA, so we only convert again when it changed. Comparing is much cheaper than converting and rebuilding the line index.
     if (is_readonly && state != NULL && (render_cursor || render_selection))
     {
-        const char* buf_end = NULL;
-        state->TextW.resize(buf_size + 1);
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
-        state->CurLenA = (int)(buf_end - buf);
-        state->CursorClamp();
+        if (state->TextA.Size == 0 || state->TextA.Size > buf_size || memcmp(state->TextA.Data, buf, (size_t)state->TextA.Size) != 0)
+        {
+            const char* buf_end = NULL;
+            state->TextW.resize(buf_size + 1);
+            state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
+            state->CurLenA = (int)(buf_end - buf);
+            const int buf_len = state->CurLenA + (int)strlen(buf_end);
+            state->TextA.resize(buf_len + 1);
+            memcpy(state->TextA.Data, buf, (size_t)buf_len + 1);
+            state->InvalidateOffsetCache();
+            state->LineIndexRebuild();
+            state->CursorClamp();
+        }
         render_selection &= state->HasSelection();
     }
 
@@ -3631,7 +4119,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         password_font->ContainerAtlas = g.Font->ContainerAtlas;
         password_font->FallbackGlyph = glyph;
         password_font->FallbackAdvanceX = glyph->AdvanceX;
-        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
+        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexPageMap.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
         PushFont(password_font);
     }
 
@@ -3660,6 +4148,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         {
             state->SelectAll();
             state->SelectedAllMouseLock = true;
+            state->UndoMergeAllowed = false;
         }
         else if (hovered && is_osx && io.MouseDoubleClicked[0])
         {
@@ -3673,6 +4162,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 stb_textedit_click(state, &state->Stb, mouse_x, mouse_y);
                 state->CursorAnimReset();
+                state->UndoMergeAllowed = false;
             }
         }
         else if (io.MouseDown[0] && !state->SelectedAllMouseLock && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
@@ -3680,6 +4170,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             stb_textedit_drag(state, &state->Stb, mouse_x, mouse_y);
             state->CursorAnimReset();
             state->CursorFollow = true;
+            state->UndoMergeAllowed = false;
         }
         if (state->SelectedAllMouseLock && !io.MouseDown[0])
             state->SelectedAllMouseLock = false;
@@ -3780,6 +4271,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         {
             state->SelectAll();
             state->CursorFollow = true;
+            state->UndoMergeAllowed = false;
         }
         else if (is_cut || is_copy)
         {
@@ -3789,17 +4281,19 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
                 const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
-                char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
+                char* clipboard_data = (char*)MemAllocFrame(clipboard_data_len * sizeof(char));
                 ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
-                MemFree(clipboard_data);
+                MemFreeFrame(clipboard_data);
             }
             if (is_cut)
             {
                 if (!state->HasSelection())
                     state->SelectAll();
                 state->CursorFollow = true;
+                state->UndoMergeAllowed = false;
                 stb_textedit_cut(state, &state->Stb);
+                state->UndoMergeAllowed = false;
             }
         }
         else if (is_paste)
@@ -3808,7 +4302,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len+1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)MemAllocFrame((clipboard_len+1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -3823,10 +4317,13 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 clipboard_filtered[clipboard_filtered_len] = 0;
                 if (clipboard_filtered_len > 0) // If everything was filtered, ignore the pasting operation
                 {
+                    // Pasting deletes the selection then inserts, which we record as a single undo record
+                    state->UndoMergeAllowed = false;
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
+                    state->UndoMergeAllowed = false;
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
+                MemFreeFrame(clipboard_filtered);
             }
         }
 
@@ -3848,13 +4345,16 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 // Push records into the undo stack so we can CTRL+Z the revert operation itself
                 apply_new_text = state->InitialTextA.Data;
                 apply_new_text_length = state->InitialTextA.Size - 1;
-                ImVector<ImWchar> w_text;
+                ImWchar* w_text = NULL;
+                int w_text_len = 0;
                 if (apply_new_text_length > 0)
                 {
-                    w_text.resize(ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1);
-                    ImTextStrFromUtf8(w_text.Data, w_text.Size, apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text_len = ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text = (ImWchar*)MemAllocFrame((size_t)(w_text_len + 1) * sizeof(ImWchar));
+                    ImTextStrFromUtf8(w_text, w_text_len + 1, apply_new_text, apply_new_text + apply_new_text_length);
                 }
-                stb_textedit_replace(state, &state->Stb, w_text.Data, (apply_new_text_length > 0) ? (w_text.Size - 1) : 0);
+                stb_textedit_replace(state, &state->Stb, w_text, w_text_len);
+                MemFreeFrame(w_text);
             }
         }
 
@@ -3867,12 +4367,12 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             // Apply new value immediately - copy modified buffer back
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
-            if (!is_readonly)
+            // The UTF-8 buffer is converted once after activation, from then on the stb_textedit callbacks apply every edit to both buffers.
+            if (!is_readonly && !state->TextAIsValid)
             {
                 state->TextAIsValid = true;
                 state->TextA.resize(state->TextW.Size * 4 + 1);
-                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                state->CurLenA = ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
             }
 
             // User callback
@@ -3916,10 +4416,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     callback_data.BufDirty = false;
 
                     // We have to convert from wchar-positions to UTF-8-positions, which can be pretty slow (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188)
-                    ImWchar* text = state->TextW.Data;
-                    const int utf8_cursor_pos = callback_data.CursorPos = ImTextCountUtf8BytesFromStr(text, text + state->Stb.cursor);
-                    const int utf8_selection_start = callback_data.SelectionStart = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_start);
-                    const int utf8_selection_end = callback_data.SelectionEnd = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_end);
+                    const int utf8_cursor_pos = callback_data.CursorPos = state->GetUtf8Offset(state->Stb.cursor);
+                    const int utf8_selection_start = callback_data.SelectionStart = state->GetUtf8Offset(state->Stb.select_start);
+                    const int utf8_selection_end = callback_data.SelectionEnd = state->GetUtf8Offset(state->Stb.select_end);
 
                     // Call user code
                     callback(&callback_data);
@@ -3934,17 +4433,23 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     if (callback_data.BufDirty)
                     {
                         IM_ASSERT(callback_data.BufTextLen == (int)strlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
+                        InputTextUndoRecordUserEdit(state, callback_data.Buf, callback_data.Buf + callback_data.BufTextLen);
                         if (callback_data.BufTextLen > backup_current_text_length && is_resizable)
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length));
                         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        state->TextAIsValid = false;                // Convert back from TextW on next frame, in case the user text didn't fully survive the conversion
+                        state->TextEdited = true;
+                        state->InvalidateOffsetCache();
+                        state->LineIndexRebuild();
                         state->CursorAnimReset();
                     }
                 }
             }
 
             // Will copy result string if modified
-            if (!is_readonly && strcmp(state->TextA.Data, buf) != 0)
+            const bool apply_on_edit_only = (flags & ImGuiInputTextFlags_ApplyOnEditOnly) != 0;
+            if (!is_readonly && (state->TextEdited || enter_pressed || !apply_on_edit_only) && strcmp(state->TextA.Data, buf) != 0)
             {
                 apply_new_text = state->TextA.Data;
                 apply_new_text_length = state->CurLenA;
@@ -3979,6 +4484,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             ImStrncpy(buf, apply_new_text, ImMin(apply_new_text_length + 1, buf_size));
             value_changed = true;
         }
+        state->TextEdited = false;
 
         // Clear temporary user storage
         state->UserFlags = 0;
@@ -4029,51 +4535,26 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // We are attempting to do most of that in **one main pass** to minimize the computation cost (non-negligible for large amount of text) + 2nd pass for selection rendering (we could merge them by an extra refactoring effort)
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
         const ImWchar* text_begin = state->TextW.Data;
+        const int* line_starts = state->LineStarts.Data;
+        const int line_count = state->LineStarts.Size;
         ImVec2 cursor_offset, select_start_offset;
+        int select_start_line = 0;
 
         {
-            // Find lines numbers straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions.
-            const ImWchar* searches_input_ptr[2] = { NULL, NULL };
-            int searches_result_line_no[2] = { -1000, -1000 };
-            int searches_remaining = 0;
+            // Find lines straddling 'cursor' and 'select_start' positions from the line index, then measure distance from the beginning of the line.
+            // Offsets are given at the bottom of the line.
             if (render_cursor)
             {
-                searches_input_ptr[0] = text_begin + state->Stb.cursor;
-                searches_result_line_no[0] = -1;
-                searches_remaining++;
+                const int cursor_line = state->LineIndexFindLine(state->Stb.cursor);
+                cursor_offset.x = InputTextCalcTextSizeW(text_begin + line_starts[cursor_line], text_begin + state->Stb.cursor).x;
+                cursor_offset.y = (cursor_line + 1) * g.FontSize;
             }
             if (render_selection)
             {
-                searches_input_ptr[1] = text_begin + ImMin(state->Stb.select_start, state->Stb.select_end);
-                searches_result_line_no[1] = -1;
-                searches_remaining++;
-            }
-
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_no[0] == -1)
-                searches_result_line_no[0] = line_count;
-            if (searches_result_line_no[1] == -1)
-                searches_result_line_no[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_no[0] * g.FontSize;
-            if (searches_result_line_no[1] >= 0)
-            {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_no[1] * g.FontSize;
+                const int select_start = ImMin(state->Stb.select_start, state->Stb.select_end);
+                select_start_line = state->LineIndexFindLine(select_start);
+                select_start_offset.x = InputTextCalcTextSizeW(text_begin + line_starts[select_start_line], text_begin + select_start).x;
+                select_start_offset.y = (select_start_line + 1) * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
@@ -4124,7 +4605,16 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            const ImWchar* p = text_selected_begin;
+
+            // Skip lines above the visible area
+            const int first_visible_line = ImMax((int)ImCeil((clip_rect.y - draw_pos.y) / g.FontSize) - 1, 0);
+            if (is_multiline && first_visible_line > select_start_line && first_visible_line < line_count && text_begin + line_starts[first_visible_line] < text_selected_end)
+            {
+                p = text_begin + line_starts[first_visible_line];
+                rect_pos = ImVec2(draw_pos.x - draw_scroll.x, draw_pos.y + (first_visible_line + 1) * g.FontSize);
+            }
+            while (p < text_selected_end)
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
@@ -4151,7 +4641,22 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         }
 
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
-        if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
+        // In multi-line mode we only render the visible lines, converted from our wchar buffer.
+        if (is_multiline && !is_displaying_hint)
+        {
+            const int line_min = ImMax((int)ImFloor((clip_rect.y - draw_pos.y) / g.FontSize), 0);
+            const int line_max = ImMin((int)ImFloor((clip_rect.w - draw_pos.y) / g.FontSize), line_count - 1);
+            if (line_min <= line_max)
+            {
+                const ImWchar* visible_begin = text_begin + line_starts[line_min];
+                const ImWchar* visible_end = (line_max + 1 < line_count) ? text_begin + line_starts[line_max + 1] : text_begin + state->CurLenW;
+                state->VisibleTextA.resize(ImTextCountUtf8BytesFromStr(visible_begin, visible_end) + 1);
+                const int visible_len_a = ImTextStrToUtf8(state->VisibleTextA.Data, state->VisibleTextA.Size, visible_begin, visible_end);
+                ImVec2 visible_pos(draw_pos.x - draw_scroll.x, draw_pos.y + line_min * g.FontSize);
+                draw_window->DrawList->AddText(g.Font, g.FontSize, visible_pos, GetColorU32(ImGuiCol_Text), state->VisibleTextA.Data, state->VisibleTextA.Data + visible_len_a);
+            }
+        }
+        else if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
             draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
@@ -5156,6 +5661,7 @@ void ImGui::ColorPickerOptionsPopup(const float* ref_col, ImGuiColorEditFlags fl
 // - GetTreeNodeToLabelSpacing()
 // - SetNextItemOpen()
 // - CollapsingHeader()
+// - ImGuiTreeClipper
 //-------------------------------------------------------------------------
 
 bool ImGui::TreeNode(const char* str_id, const char* fmt, ...)
@@ -5579,6 +6085,175 @@ bool ImGui::CollapsingHeader(const char* label, bool* p_open, ImGuiTreeNodeFlags
     return is_open;
 }
 
+// Flatten the nodes whose parents are all open into rows, skipping closed subtrees without querying their nodes.
+static void TreeClipperBuildRows(ImGuiTreeClipperState* state, int nodes_count, ImGuiTreeClipperGetter getter, void* user_data, ImGuiTreeNodeFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiStorage* storage = g.CurrentWindow->DC.StateStorage;
+    const int default_open = (flags & ImGuiTreeNodeFlags_DefaultOpen) ? 1 : 0;
+    ImVector<ImGuiTreeClipperRow>& rows = state->Rows;
+    rows.resize(0);
+    state->NodesCount = nodes_count;
+
+    int parent_row = -1;
+    for (int node_idx = 0; node_idx < nodes_count; )
+    {
+        // Leave the subtrees ending before this node
+        while (parent_row >= 0 && node_idx > rows[parent_row].NodeIdx + rows[parent_row].DescendantsCount)
+            parent_row = rows[parent_row].ParentRow;
+
+        int descendants_count = 0;
+        ImGuiID node_id = (ImGuiID)node_idx;
+        getter(user_data, node_idx, &descendants_count, &node_id);
+        IM_ASSERT(descendants_count >= 0 && node_idx + descendants_count < nodes_count);
+
+        ImGuiTreeClipperRow row;
+        row.NodeIdx = node_idx;
+        row.DescendantsCount = descendants_count;
+        row.ParentRow = parent_row;
+        row.Depth = (parent_row >= 0) ? rows[parent_row].Depth + 1 : 0;
+        row.ID = ImHashData(&node_id, sizeof(node_id), state->ID);
+        row.IsOpen = descendants_count > 0 && storage->GetInt(row.ID, default_open) != 0;
+        rows.push_back(row);
+        if (row.IsOpen)
+        {
+            parent_row = rows.Size - 1;
+            node_idx++;
+        }
+        else
+        {
+            node_idx += 1 + descendants_count;
+        }
+    }
+}
+
+ImGuiTreeClipper::ImGuiTreeClipper(const char* str_id, int nodes_count, ImGuiTreeClipperGetter getter, void* user_data, ImGuiTreeNodeFlags flags, float items_height)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    const ImGuiID id = window->GetID(str_id);
+    ImGuiTreeClipperState* state = g.TreeClippers.GetOrAddByKey(id);
+    state->ID = id;
+    StateIdx = g.TreeClippers.GetIndex(state);
+    Getter = getter;
+    UserData = user_data;
+    NodesCount = nodes_count;
+    Flags = flags;
+    ItemsHeight = (items_height > 0.0f) ? items_height : ImGui::GetTextLineHeightWithSpacing();
+    DisplayStart = DisplayEnd = -1;
+    RowsCount = -1;
+    NavRow = -1;
+}
+
+bool ImGuiTreeClipper::Step()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (RowsCount < 0)
+    {
+        // First step: rebuild the rows if needed, then clip them as a list of evenly sized items
+        ImGuiTreeClipperState* state = g.TreeClippers.GetByIndex(StateIdx);
+        state->LastFrameActive = g.FrameCount;
+        if (window->SkipItems)
+        {
+            RowsCount = 0;
+            return false;
+        }
+        if (state->NodesCount != NodesCount)
+            TreeClipperBuildRows(state, NodesCount, Getter, UserData, Flags);
+        RowsCount = state->Rows.Size;
+        ListClipper.Begin(RowsCount, ItemsHeight);
+    }
+    if (!ListClipper.Step())
+    {
+        End();
+        return false;
+    }
+    DisplayStart = ListClipper.DisplayStart;
+    DisplayEnd = ListClipper.DisplayEnd;
+    return true;
+}
+
+void ImGuiTreeClipper::End()
+{
+    ListClipper.End();
+    if (NavRow < 0)
+        return;
+
+    // Handle Left arrow to move to the parent row (equivalent of what TreePop() does when ImGuiTreeNodeFlags_NavLeftJumpsBackHere is enabled).
+    // The parent row may be clipped, so we compute its rectangle from its position in the list and scroll it into view.
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiTreeClipperState* state = g.TreeClippers.GetByIndex(StateIdx);
+    const int parent_row = state->Rows[NavRow].ParentRow;
+    NavRow = -1;
+    if (!(Flags & ImGuiTreeNodeFlags_NavLeftJumpsBackHere) || parent_row < 0)
+        return;
+    if (g.NavMoveDir == ImGuiDir_Left && g.NavWindow == window && ImGui::NavMoveRequestButNoResultYet())
+    {
+        const ImGuiTreeClipperRow& parent = state->Rows[parent_row];
+        ImRect rect_abs;
+        rect_abs.Min.x = window->DC.CursorPos.x + parent.Depth * g.Style.IndentSpacing;
+        rect_abs.Min.y = ListClipper.StartPosY + parent_row * ItemsHeight;
+        rect_abs.Max.x = rect_abs.Min.x + ImGui::GetTreeNodeToLabelSpacing();
+        rect_abs.Max.y = rect_abs.Min.y + ItemsHeight - g.Style.ItemSpacing.y;
+        ImVec2 delta_scroll;
+        if (g.NavLayer == 0)
+            delta_scroll = ImGui::ScrollToBringRectIntoView(window, rect_abs);
+        ImGui::SetNavIDWithRectRel(parent.ID, g.NavLayer, window->DC.NavFocusScopeIdCurrent, ImRect(rect_abs.Min - window->Pos - delta_scroll, rect_abs.Max - window->Pos - delta_scroll));
+        ImGui::NavMoveRequestCancel();
+    }
+}
+
+void ImGuiTreeClipper::Invalidate()
+{
+    ImGuiContext& g = *GImGui;
+    g.TreeClippers.GetByIndex(StateIdx)->NodesCount = -1;
+}
+
+bool ImGuiTreeClipper::TreeNode(int row_idx, const char* label, ImGuiTreeNodeFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiTreeClipperState* state = g.TreeClippers.GetByIndex(StateIdx);
+    const ImGuiTreeClipperRow& row = state->Rows[row_idx];
+    const bool is_leaf = (row.DescendantsCount == 0);
+    flags |= Flags | ImGuiTreeNodeFlags_NoTreePushOnOpen | (is_leaf ? ImGuiTreeNodeFlags_Leaf : 0);
+
+    // Indent by depth instead of having the parents pushed, which may be clipped
+    const float indent_w = row.Depth * g.Style.IndentSpacing;
+    if (indent_w > 0.0f)
+        ImGui::Indent(indent_w);
+    window->DC.TreeDepth += row.Depth;
+    bool is_open = ImGui::TreeNodeBehavior(row.ID, flags, label, NULL);
+    window->DC.TreeDepth -= row.Depth;
+    if (indent_w > 0.0f)
+        ImGui::Unindent(indent_w);
+
+    if (row.ID == g.NavId)
+        NavRow = row_idx;
+
+    // Rebuild the rows on next frame when the node got opened/closed (by the user or SetNextItemOpen)
+    if (!is_leaf && (window->DC.StateStorage->GetInt(row.ID, (Flags & ImGuiTreeNodeFlags_DefaultOpen) ? 1 : 0) != 0) != row.IsOpen)
+        state->NodesCount = -1;
+    return is_open;
+}
+
+int ImGuiTreeClipper::GetNodeIdx(int row) const
+{
+    return GImGui->TreeClippers.GetByIndex(StateIdx)->Rows[row].NodeIdx;
+}
+
+int ImGuiTreeClipper::GetDepth(int row) const
+{
+    return GImGui->TreeClippers.GetByIndex(StateIdx)->Rows[row].Depth;
+}
+
+ImGuiID ImGuiTreeClipper::GetID(int row) const
+{
+    return GImGui->TreeClippers.GetByIndex(StateIdx)->Rows[row].ID;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Selectable
 //-------------------------------------------------------------------------
@@ -5596,9 +6271,6 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
 
-    if ((flags & ImGuiSelectableFlags_SpanAllColumns) && window->DC.CurrentColumns) // FIXME-OPT: Avoid if vertically clipped.
-        PushColumnsBackground();
-
     ImGuiID id = window->GetID(label);
     ImVec2 label_size = CalcTextSize(label, NULL, true);
     ImVec2 size(size_arg.x != 0.0f ? size_arg.x : label_size.x, size_arg.y != 0.0f ? size_arg.y : label_size.y);
@@ -5626,6 +6298,14 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     bb.Max.x += (spacing_x - spacing_L);
     bb.Max.y += (spacing_y - spacing_U);
 
+    // Spanning all columns draws in the columns background, which we don't switch to if ItemAdd() is going to clip us vertically anyway
+    // (the columns clip rectangles only differ horizontally from the background one).
+    bool span_all_columns = (flags & ImGuiSelectableFlags_SpanAllColumns) && window->DC.CurrentColumns;
+    if (span_all_columns && (bb.Min.y >= window->ClipRect.Max.y || bb.Max.y <= window->ClipRect.Min.y) && id != g.ActiveId && !g.LogEnabled)
+        span_all_columns = false;
+    if (span_all_columns)
+        PushColumnsBackground();
+
     bool item_add;
     if (flags & ImGuiSelectableFlags_Disabled)
     {
@@ -5640,7 +6320,7 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     }
     if (!item_add)
     {
-        if ((flags & ImGuiSelectableFlags_SpanAllColumns) && window->DC.CurrentColumns)
+        if (span_all_columns)
             PopColumnsBackground();
         return false;
     }
@@ -5690,7 +6370,7 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
         RenderNavHighlight(bb, id, ImGuiNavHighlightFlags_TypeThin | ImGuiNavHighlightFlags_NoRounding);
     }
 
-    if ((flags & ImGuiSelectableFlags_SpanAllColumns) && window->DC.CurrentColumns)
+    if (span_all_columns)
     {
         PopColumnsBackground();
         bb.Max.x -= (GetContentRegionMax().x - max_x);
@@ -5845,47 +6525,635 @@ bool ImGui::ListBox(const char* label, int* current_item, bool (*items_getter)(v
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: PlotLines, PlotHistogram
 //-------------------------------------------------------------------------
+// - ImGuiPlotStream
 // - PlotEx() [Internal]
 // - PlotLines()
 // - PlotHistogram()
 //-------------------------------------------------------------------------
 
-void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 frame_size)
+static inline ImVec2 PlotStreamLeaf(float v)                     { return (v != v) ? ImVec2(FLT_MAX, -FLT_MAX) : ImVec2(v, v); } // NaN values are ignored
+static inline ImVec2 PlotStreamMerge(const ImVec2& a, const ImVec2& b) { return ImVec2(ImMin(a.x, b.x), ImMax(a.y, b.y)); }
+
+ImGuiPlotStream::ImGuiPlotStream(int capacity, int queue_capacity)
 {
-    ImGuiWindow* window = GetCurrentWindow();
-    if (window->SkipItems)
-        return;
+    IM_ASSERT(capacity > 0);
+    Queue.resize(ImUpperPowerOfTwo(queue_capacity > 0 ? queue_capacity : capacity));
+    QueueHead = QueueTail = DroppedCount = 0;
+    Capacity = capacity;
+    Values.resize(capacity);
+    TreeLeaves = ImUpperPowerOfTwo(capacity);
+    Tree.resize(TreeLeaves * 2);
+    ClearCount = 0;
+    Clear();
+}
 
-    ImGuiContext& g = *GImGui;
-    const ImGuiStyle& style = g.Style;
-    const ImGuiID id = window->GetID(label);
+// Producer side: only reads QueueHead and publishes the value by advancing QueueTail
+bool ImGuiPlotStream::Push(float v)
+{
+    const unsigned long tail = (unsigned long)QueueTail;
+    if (tail - (unsigned long)ImAtomicLoad(&QueueHead) >= (unsigned long)Queue.Size)
+    {
+        ImAtomicStore(&DroppedCount, DroppedCount + 1);
+        return false;
+    }
+    Queue.Data[tail & (unsigned long)(Queue.Size - 1)] = v;
+    ImAtomicStore(&QueueTail, (long)(tail + 1));
+    return true;
+}
 
-    const ImVec2 label_size = CalcTextSize(label, NULL, true);
-    if (frame_size.x == 0.0f)
-        frame_size.x = CalcItemWidth();
-    if (frame_size.y == 0.0f)
-        frame_size.y = label_size.y + (style.FramePadding.y * 2);
+void ImGuiPlotStream::Update()
+{
+    const unsigned long head = (unsigned long)QueueHead;
+    const unsigned long tail = (unsigned long)ImAtomicLoad(&QueueTail);
+    if (head == tail)
+        return;
 
-    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + frame_size);
-    const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
+    // Large batches update the leaves and rebuild the tree in a single pass, instead of walking up the tree for each value
+    const bool rebuild = (tail - head) > (unsigned long)(Capacity / 16);
+    int slot = (int)(Count % Capacity);
+    for (unsigned long n = head; n != tail; n++)
+    {
+        const float v = Queue.Data[n & (unsigned long)(Queue.Size - 1)];
+        Values.Data[slot] = v;
+        int node = TreeLeaves + slot;
+        Tree.Data[node] = PlotStreamLeaf(v);
+        if (!rebuild)
+            for (node >>= 1; node > 0; node >>= 1)
+                Tree.Data[node] = PlotStreamMerge(Tree.Data[node * 2], Tree.Data[node * 2 + 1]);
+        if (++slot == Capacity)
+            slot = 0;
+    }
+    Count += (ImS64)(tail - head);
+    ImAtomicStore(&QueueHead, (long)tail);
+    if (rebuild)
+        for (int node = TreeLeaves - 1; node > 0; node--)
+            Tree.Data[node] = PlotStreamMerge(Tree.Data[node * 2], Tree.Data[node * 2 + 1]);
+}
+
+void ImGuiPlotStream::Clear()
+{
+    Count = 0;
+    ClearCount++;
+    for (int n = 0; n < Tree.Size; n++)
+        Tree.Data[n] = ImVec2(FLT_MAX, -FLT_MAX);
+}
+
+void ImGuiPlotStream::GetMinMax(int first, int count, float* out_min, float* out_max) const
+{
+    IM_ASSERT(first >= 0 && count >= 0 && first + count <= GetSize());
+    ImVec2 min_max(FLT_MAX, -FLT_MAX);
+    int slot_start = (int)((Count - GetSize() + first) % Capacity);
+    while (count > 0)
+    {
+        // Query slots [slot_start, slot_end) of the ring, in up to two parts
+        const int slot_end = ImMin(slot_start + count, Capacity);
+        count -= slot_end - slot_start;
+        for (int l = slot_start + TreeLeaves, r = slot_end + TreeLeaves; l < r; l >>= 1, r >>= 1)
+        {
+            if (l & 1)
+                min_max = PlotStreamMerge(min_max, Tree.Data[l++]);
+            if (r & 1)
+                min_max = PlotStreamMerge(min_max, Tree.Data[--r]);
+        }
+        slot_start = 0;
+    }
+    *out_min = min_max.x;
+    *out_max = min_max.y;
+}
+
+struct ImGuiPlotArrayGetterData
+{
+    const void* Values;
+    ImGuiDataType DataType;
+    int Stride;
+
+    ImGuiPlotArrayGetterData(const void* values, ImGuiDataType data_type, int stride) { Values = values; DataType = data_type; Stride = stride; }
+};
+
+static float Plot_ArrayGetter(void* data, int idx)
+{
+    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
+    const void* p = (const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
+    switch (plot_data->DataType)
+    {
+    case ImGuiDataType_S8:     return (float)*(const ImS8*)p;
+    case ImGuiDataType_U8:     return (float)*(const ImU8*)p;
+    case ImGuiDataType_S16:    return (float)*(const ImS16*)p;
+    case ImGuiDataType_U16:    return (float)*(const ImU16*)p;
+    case ImGuiDataType_S32:    return (float)*(const ImS32*)p;
+    case ImGuiDataType_U32:    return (float)*(const ImU32*)p;
+    case ImGuiDataType_S64:    return (float)*(const ImS64*)p;
+    case ImGuiDataType_U64:    return (float)*(const ImU64*)p;
+    case ImGuiDataType_Float:  return *(const float*)p;
+    case ImGuiDataType_Double: return (float)*(const double*)p;
+    case ImGuiDataType_COUNT:  break;
+    }
+    IM_ASSERT(0);
+    return 0.0f;
+}
+
+// Return the values when PlotEx() is given an array of tightly packed values, which we read directly instead of through the getter
+static const void* PlotGetContiguousValues(float (*values_getter)(void* data, int idx), void* data, ImGuiDataType* out_data_type)
+{
+    if (values_getter != &Plot_ArrayGetter)
+        return NULL;
+    ImGuiPlotArrayGetterData* array_data = (ImGuiPlotArrayGetterData*)data;
+    if ((size_t)array_data->Stride != ImGui::DataTypeGetInfo(array_data->DataType)->Size)
+        return NULL;
+    *out_data_type = array_data->DataType;
+    return array_data->Values;
+}
+
+static float Plot_StreamGetter(void* data, int idx)
+{
+    const ImGuiPlotStream* stream = (const ImGuiPlotStream*)data;
+    return (*stream)[idx];
+}
+
+// First value index of a pixel column, when decimating 'values_count' values to 'columns' columns
+static inline int PlotGetColumnStart(int column, int values_count, int columns)
+{
+    return (int)(((ImS64)column * values_count) / columns);
+}
+
+// Value at logical index 'idx' of a ring buffer starting at 'values_offset' (which is < values_count)
+static inline float PlotGetValue(float (*values_getter)(void* data, int idx), void* data, const float* values, int values_count, int values_offset, int idx)
+{
+    idx += values_offset;
+    if (idx >= values_count)
+        idx -= values_count;
+    return values ? values[idx] : values_getter(data, idx);
+}
+
+// Min/max of contiguous values. NaN are ignored: comparisons with them are false.
+// Four independent accumulators let the compiler vectorize the loop.
+template<typename TYPE>
+static void PlotScanMinMaxT(const TYPE* values, int count, float* p_min, float* p_max)
+{
+    int n = 0;
+    while (n < count && values[n] != values[n]) // Skip leading NaN values (no-op for integers)
+        n++;
+    if (n == count)
+        return;
+    TYPE min0 = values[n], min1 = min0, min2 = min0, min3 = min0;
+    TYPE max0 = values[n], max1 = max0, max2 = max0, max3 = max0;
+    for (; n + 4 <= count; n += 4)
+    {
+        const TYPE v0 = values[n], v1 = values[n + 1], v2 = values[n + 2], v3 = values[n + 3];
+        min0 = (v0 < min0) ? v0 : min0; max0 = (v0 > max0) ? v0 : max0;
+        min1 = (v1 < min1) ? v1 : min1; max1 = (v1 > max1) ? v1 : max1;
+        min2 = (v2 < min2) ? v2 : min2; max2 = (v2 > max2) ? v2 : max2;
+        min3 = (v3 < min3) ? v3 : min3; max3 = (v3 > max3) ? v3 : max3;
+    }
+    for (; n < count; n++)
+    {
+        const TYPE v = values[n];
+        min0 = (v < min0) ? v : min0;
+        max0 = (v > max0) ? v : max0;
+    }
+    *p_min = ImMin(*p_min, (float)ImMin(ImMin(min0, min1), ImMin(min2, min3)));
+    *p_max = ImMax(*p_max, (float)ImMax(ImMax(max0, max1), ImMax(max2, max3)));
+}
+
+#ifdef IMGUI_ENABLE_SSE
+// MINPS/MAXPS return their second operand when either is NaN, so NaN values are ignored as well
+template<>
+void PlotScanMinMaxT<float>(const float* values, int count, float* p_min, float* p_max)
+{
+    __m128 min0 = _mm_set1_ps(*p_min), min1 = min0;
+    __m128 max0 = _mm_set1_ps(*p_max), max1 = max0;
+    int n = 0;
+    for (; n + 8 <= count; n += 8)
+    {
+        const __m128 v0 = _mm_loadu_ps(values + n);
+        const __m128 v1 = _mm_loadu_ps(values + n + 4);
+        min0 = _mm_min_ps(v0, min0); max0 = _mm_max_ps(v0, max0);
+        min1 = _mm_min_ps(v1, min1); max1 = _mm_max_ps(v1, max1);
+    }
+    float mins[4], maxs[4];
+    _mm_storeu_ps(mins, _mm_min_ps(min0, min1));
+    _mm_storeu_ps(maxs, _mm_max_ps(max0, max1));
+    float v_min = ImMin(ImMin(mins[0], mins[1]), ImMin(mins[2], mins[3]));
+    float v_max = ImMax(ImMax(maxs[0], maxs[1]), ImMax(maxs[2], maxs[3]));
+    for (; n < count; n++)
+    {
+        const float v = values[n];
+        v_min = (v < v_min) ? v : v_min;
+        v_max = (v > v_max) ? v : v_max;
+    }
+    *p_min = v_min;
+    *p_max = v_max;
+}
+#endif
+
+static void PlotScanMinMax(ImGuiDataType data_type, const void* values, int count, float* p_min, float* p_max)
+{
+    switch (data_type)
+    {
+    case ImGuiDataType_S8:     PlotScanMinMaxT<ImS8  >((const ImS8*  )values, count, p_min, p_max); return;
+    case ImGuiDataType_U8:     PlotScanMinMaxT<ImU8  >((const ImU8*  )values, count, p_min, p_max); return;
+    case ImGuiDataType_S16:    PlotScanMinMaxT<ImS16 >((const ImS16* )values, count, p_min, p_max); return;
+    case ImGuiDataType_U16:    PlotScanMinMaxT<ImU16 >((const ImU16* )values, count, p_min, p_max); return;
+    case ImGuiDataType_S32:    PlotScanMinMaxT<ImS32 >((const ImS32* )values, count, p_min, p_max); return;
+    case ImGuiDataType_U32:    PlotScanMinMaxT<ImU32 >((const ImU32* )values, count, p_min, p_max); return;
+    case ImGuiDataType_S64:    PlotScanMinMaxT<ImS64 >((const ImS64* )values, count, p_min, p_max); return;
+    case ImGuiDataType_U64:    PlotScanMinMaxT<ImU64 >((const ImU64* )values, count, p_min, p_max); return;
+    case ImGuiDataType_Float:  PlotScanMinMaxT<float >((const float* )values, count, p_min, p_max); return;
+    case ImGuiDataType_Double: PlotScanMinMaxT<double>((const double*)values, count, p_min, p_max); return;
+    case ImGuiDataType_COUNT:  break;
+    }
+    IM_ASSERT(0);
+}
+
+// Min/max envelope of each pixel column. 'values' is set when the data is a contiguous array, bypassing the getter.
+static void PlotDecimateMinMax(ImGuiPlotState* plot, float (*values_getter)(void* data, int idx), void* data, const void* values, ImGuiDataType data_type, int values_count, int values_offset, int columns)
+{
+    const size_t value_size = values ? ImGui::DataTypeGetInfo(data_type)->Size : 0;
+    plot->Points.resize(columns);
+    float all_min = FLT_MAX, all_max = -FLT_MAX;
+    for (int column = 0; column < columns; column++)
+    {
+        const int idx_start = PlotGetColumnStart(column, values_count, columns);
+        const int idx_end = PlotGetColumnStart(column + 1, values_count, columns);
+        float v_min = FLT_MAX, v_max = -FLT_MAX;
+        if (values)
+        {
+            // Ring buffer: the column range is at most two contiguous spans
+            int span_start = idx_start + values_offset;
+            if (span_start >= values_count)
+                span_start -= values_count;
+            const int span_count = ImMin(idx_end - idx_start, values_count - span_start);
+            PlotScanMinMax(data_type, (const unsigned char*)values + span_start * value_size, span_count, &v_min, &v_max);
+            PlotScanMinMax(data_type, values, idx_end - idx_start - span_count, &v_min, &v_max);
+        }
+        else
+        {
+            for (int idx = idx_start; idx < idx_end; idx++)
+            {
+                const float v = PlotGetValue(values_getter, data, NULL, values_count, values_offset, idx);
+                v_min = (v < v_min) ? v : v_min;
+                v_max = (v > v_max) ? v : v_max;
+            }
+        }
+        plot->Points[column] = ImVec2(v_min, v_max);
+        all_min = ImMin(all_min, v_min);
+        all_max = ImMax(all_max, v_max);
+    }
+    plot->ValuesMin = all_min;
+    plot->ValuesMax = all_max;
+}
+
+// Largest-Triangle-Three-Buckets: keep the first and last values, and in each bucket in between the value forming the largest triangle
+// with the previously kept one and the average of the next bucket.
+static void PlotDecimateLTTB(ImGuiPlotState* plot, float (*values_getter)(void* data, int idx), void* data, const float* values, int values_count, int values_offset, int threshold)
+{
+    plot->Points.resize(0);
+    float all_min = FLT_MAX, all_max = -FLT_MAX;
+    const float v_first = PlotGetValue(values_getter, data, values, values_count, values_offset, 0);
+    const float v_last = PlotGetValue(values_getter, data, values, values_count, values_offset, values_count - 1);
+    if (threshold >= values_count || threshold < 3)
+    {
+        for (int idx = 0; idx < values_count; idx++)
+        {
+            const float v = PlotGetValue(values_getter, data, values, values_count, values_offset, idx);
+            plot->Points.push_back(ImVec2((float)idx, v));
+        }
+    }
+    else
+    {
+        plot->Points.reserve(threshold);
+        plot->Points.push_back(ImVec2(0.0f, v_first));
+        const double bucket_size = (double)(values_count - 2) / (threshold - 2);
+        ImVec2 a = plot->Points[0];
+        for (int bucket = 0; bucket < threshold - 2; bucket++)
+        {
+            // Average of the next bucket (the last value for the last bucket)
+            const int avg_start = (int)((bucket + 1) * bucket_size) + 1;
+            const int avg_end = ImMin((int)((bucket + 2) * bucket_size) + 1, values_count);
+            float avg_x = 0.0f, avg_y = 0.0f;
+            int avg_count = 0;
+            for (int idx = avg_start; idx < avg_end; idx++)
+            {
+                const float v = PlotGetValue(values_getter, data, values, values_count, values_offset, idx);
+                if (v != v) // Ignore NaN values
+                    continue;
+                avg_x += (float)idx;
+                avg_y += v;
+                avg_count++;
+            }
+            if (avg_count > 0)
+            {
+                avg_x /= avg_count;
+                avg_y /= avg_count;
+            }
+            else
+            {
+                avg_x = (float)avg_start;
+                avg_y = a.y;
+            }
+
+            // Value of this bucket with the largest triangle area
+            const int range_start = (int)(bucket * bucket_size) + 1;
+            const int range_end = (int)((bucket + 1) * bucket_size) + 1;
+            float area_max = -1.0f;
+            ImVec2 selected;
+            for (int idx = range_start; idx < range_end; idx++)
+            {
+                const float v = PlotGetValue(values_getter, data, values, values_count, values_offset, idx);
+                all_min = (v < all_min) ? v : all_min;
+                all_max = (v > all_max) ? v : all_max;
+                const float area = ImFabs((a.x - avg_x) * (v - a.y) - (a.x - (float)idx) * (avg_y - a.y));
+                if (area > area_max) // False for NaN values
+                {
+                    area_max = area;
+                    selected = ImVec2((float)idx, v);
+                }
+            }
+            if (area_max < 0.0f)
+                continue;
+            plot->Points.push_back(selected);
+            a = selected;
+        }
+        plot->Points.push_back(ImVec2((float)(values_count - 1), v_last));
+    }
+    for (int n = 0; n < plot->Points.Size; n++)
+    {
+        const float v = plot->Points[n].y;
+        all_min = (v < all_min) ? v : all_min;
+        all_max = (v > all_max) ? v : all_max;
+    }
+    plot->ValuesMin = all_min;
+    plot->ValuesMax = all_max;
+}
+
+// Decimate values to 'columns' pixel columns, reusing last frame result with ImGuiPlotFlags_StaticData
+static ImGuiPlotState* PlotUpdateDecimation(ImGuiID id, ImGuiPlotType plot_type, ImGuiPlotFlags flags, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, int columns)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiPlotState* plot = g.Plots.GetOrAddByKey(id);
+    plot->ID = id;
+    plot->LastFrameActive = g.FrameCount;
+
+    // Arrays are identified by their values, not by the getter data which lives on the caller stack
+    const void* source_data = data;
+    ImGuiDataType source_data_type = -1;
+    int source_stride = 0;
+    if (values_getter == &Plot_ArrayGetter)
+    {
+        ImGuiPlotArrayGetterData* array_data = (ImGuiPlotArrayGetterData*)data;
+        source_data = array_data->Values;
+        source_data_type = array_data->DataType;
+        source_stride = array_data->Stride;
+    }
+    ImGuiDataType data_type = ImGuiDataType_Float;
+    const void* values = PlotGetContiguousValues(values_getter, data, &data_type);
+
+    const ImGuiPlotFlags mode = ((flags & ImGuiPlotFlags_DecimateLTTB) && plot_type == ImGuiPlotType_Lines) ? ImGuiPlotFlags_DecimateLTTB : ImGuiPlotFlags_Decimate;
+    if ((flags & ImGuiPlotFlags_StaticData) && plot->SourceData == source_data && plot->SourceGetter == values_getter && plot->SourceDataType == source_data_type && plot->SourceStride == source_stride &&
+        plot->ValuesCount == values_count && plot->ValuesOffset == values_offset && plot->Columns == columns && plot->Mode == mode)
+        return plot;
+
+    plot->SourceData = source_data;
+    plot->SourceGetter = values_getter;
+    plot->SourceDataType = source_data_type;
+    plot->SourceStride = source_stride;
+    plot->ValuesCount = values_count;
+    plot->ValuesOffset = values_offset;
+    plot->Columns = columns;
+    plot->Mode = mode;
+    plot->SamplesPerColumn = 0;
+    if (mode == ImGuiPlotFlags_DecimateLTTB)
+        PlotDecimateLTTB(plot, values_getter, data, (data_type == ImGuiDataType_Float) ? (const float*)values : NULL, values_count, values_offset, columns);
+    else
+        PlotDecimateMinMax(plot, values_getter, data, values, data_type, values_count, values_offset, columns);
+    return plot;
+}
+
+static inline int PlotGetStreamColumnSlot(ImS64 column, int columns)
+{
+    const int slot = (int)(column % columns);
+    return (slot < 0) ? slot + columns : slot;
+}
+
+// Min/max of a column, in display order
+static inline const ImVec2& PlotGetColumn(const ImGuiPlotState* plot, int column)
+{
+    if (plot->SamplesPerColumn == 0)
+        return plot->Points[column];
+    return plot->Points[PlotGetStreamColumnSlot(plot->StreamFirstColumn + column, plot->Columns)];
+}
+
+// Range of values [*out_start, *out_end) covered by a column, may be empty for streams
+static void PlotGetColumnRange(const ImGuiPlotState* plot, int column, int* out_start, int* out_end)
+{
+    if (plot->SamplesPerColumn == 0)
+    {
+        *out_start = PlotGetColumnStart(column, plot->ValuesCount, plot->Columns);
+        *out_end = PlotGetColumnStart(column + 1, plot->ValuesCount, plot->Columns);
+        return;
+    }
+    const ImS64 oldest = plot->StreamCount - plot->ValuesCount;
+    const ImS64 start = (plot->StreamFirstColumn + column) * plot->SamplesPerColumn;
+    *out_start = (int)(ImClamp(start, oldest, plot->StreamCount) - oldest);
+    *out_end = (int)(ImClamp(start + plot->SamplesPerColumn, oldest, plot->StreamCount) - oldest);
+}
+
+static void PlotUpdateStreamColumn(ImGuiPlotState* plot, const ImGuiPlotStream* stream, ImS64 column)
+{
+    const ImS64 oldest = stream->Count - stream->GetSize();
+    const ImS64 start = ImMax(column * plot->SamplesPerColumn, oldest);
+    const ImS64 end = ImMin((column + 1) * plot->SamplesPerColumn, stream->Count);
+    ImVec2 min_max(FLT_MAX, -FLT_MAX);
+    if (start < end)
+        stream->GetMinMax((int)(start - oldest), (int)(end - start), &min_max.x, &min_max.y);
+    plot->Points[PlotGetStreamColumnSlot(column, plot->Columns)] = min_max;
+}
+
+// Streams are always decimated to min/max columns aligned on absolute value numbers: as the plot scrolls,
+// only the columns receiving new values (and the oldest ones, losing values) are computed again.
+static ImGuiPlotState* PlotUpdateStream(ImGuiID id, const ImGuiPlotStream* stream, int columns)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiPlotState* plot = g.Plots.GetOrAddByKey(id);
+    plot->ID = id;
+    plot->LastFrameActive = g.FrameCount;
+
+    const int samples_per_column = (stream->Capacity + columns - 1) / columns;
+    const ImS64 last_column = (stream->Count > 0) ? (stream->Count - 1) / samples_per_column : 0;
+    const ImS64 first_column = last_column - columns + 1;
+    ImS64 update_column = first_column;
+    if (plot->SourceData == stream && plot->SourceGetter == &Plot_StreamGetter && plot->Columns == columns && plot->SamplesPerColumn == samples_per_column &&
+        plot->StreamClearCount == stream->ClearCount && plot->StreamCount <= stream->Count && plot->Points.Size == columns)
+    {
+        update_column = ImMax(first_column, plot->StreamCount / samples_per_column);
+    }
+    else
+    {
+        plot->SourceData = stream;
+        plot->SourceGetter = &Plot_StreamGetter;
+        plot->SourceDataType = -1;
+        plot->SourceStride = 0;
+        plot->Columns = columns;
+        plot->SamplesPerColumn = samples_per_column;
+        plot->Mode = ImGuiPlotFlags_Decimate;
+        plot->Points.resize(columns);
+    }
+
+    // Columns covering values removed from the history, then columns receiving new values
+    const ImS64 oldest_column = (stream->Count - stream->GetSize()) / samples_per_column;
+    for (ImS64 column = first_column; column <= oldest_column && column < update_column; column++)
+        PlotUpdateStreamColumn(plot, stream, column);
+    for (ImS64 column = update_column; column <= last_column; column++)
+        PlotUpdateStreamColumn(plot, stream, column);
+    plot->StreamCount = stream->Count;
+    plot->StreamClearCount = stream->ClearCount;
+    plot->StreamFirstColumn = first_column;
+    plot->ValuesCount = stream->GetSize();
+    plot->ValuesOffset = 0;
+    plot->ValuesMin = FLT_MAX;
+    plot->ValuesMax = -FLT_MAX;
+    stream->GetMinMax(0, stream->GetSize(), &plot->ValuesMin, &plot->ValuesMax);
+    return plot;
+}
+
+// Render decimated data, as a single polyline for lines and a single batch of rectangles for histograms
+static void PlotRenderDecimated(ImGuiPlotType plot_type, ImGuiPlotState* plot, const ImRect& inner_bb, float scale_min, float scale_max, int column_hovered)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawList* draw_list = g.CurrentWindow->DrawList;
+    const ImU32 col_base = ImGui::GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
+    const ImU32 col_hovered = ImGui::GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
+    const float width = inner_bb.GetWidth();
+    const float height = inner_bb.GetHeight();
+    const int columns = plot->Columns;
+    const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
+
+    if (plot->Mode == ImGuiPlotFlags_DecimateLTTB)
+    {
+        ImVec2* points = (ImVec2*)ImGui::MemAllocFrame(sizeof(ImVec2) * plot->Points.Size);
+        int points_count = 0;
+        const float x_scale = width / (float)ImMax(plot->ValuesCount - 1, 1);
+        for (int n = 0; n < plot->Points.Size; n++)
+        {
+            const ImVec2& p = plot->Points[n];
+            if (p.y != p.y) // Skip NaN values
+                continue;
+            points[points_count++] = ImVec2(inner_bb.Min.x + p.x * x_scale, inner_bb.Min.y + height * (1.0f - ImSaturate((p.y - scale_min) * inv_scale)));
+        }
+        draw_list->AddPolyline(points, points_count, col_base, false, 1.0f);
+        ImGui::MemFreeFrame(points);
+        return;
+    }
+
+    if (plot_type == ImGuiPlotType_Lines)
+    {
+        // Two points per column, ordered to join the previous column with the shortest segment
+        ImVec2* points = (ImVec2*)ImGui::MemAllocFrame(sizeof(ImVec2) * columns * 2);
+        int points_count = 0;
+        const float x_step = width / (float)ImMax(columns - 1, 1);
+        float y_prev = 0.0f;
+        for (int column = 0; column < columns; column++)
+        {
+            const ImVec2& min_max = PlotGetColumn(plot, column);
+            if (min_max.x > min_max.y) // Only NaN values
+                continue;
+            const float x = inner_bb.Min.x + column * x_step;
+            const float y_min = inner_bb.Min.y + height * (1.0f - ImSaturate((min_max.x - scale_min) * inv_scale));
+            const float y_max = inner_bb.Min.y + height * (1.0f - ImSaturate((min_max.y - scale_min) * inv_scale));
+            const bool min_first = (points_count == 0) || ImFabs(y_prev - y_min) <= ImFabs(y_prev - y_max);
+            points[points_count++] = ImVec2(x, min_first ? y_min : y_max);
+            if (y_min != y_max)
+                points[points_count++] = ImVec2(x, min_first ? y_max : y_min);
+            y_prev = points[points_count - 1].y;
+            if (column == column_hovered)
+                draw_list->AddLine(ImVec2(x, y_min - 0.5f), ImVec2(x, y_max + 0.5f), col_hovered);
+        }
+        draw_list->AddPolyline(points, points_count, col_base, false, 1.0f);
+        ImGui::MemFreeFrame(points);
+    }
+    else
+    {
+        // Bars cover the whole envelope down (or up) to the zero line
+        const float zero_line_t = (scale_min * scale_max < 0.0f) ? (1.0f + scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);
+        int rects_count = 0;
+        for (int column = 0; column < columns; column++)
+            if (PlotGetColumn(plot, column).x <= PlotGetColumn(plot, column).y)
+                rects_count++;
+        draw_list->PrimReserve(rects_count * 6, rects_count * 4);
+        const float x_step = width / (float)columns;
+        for (int column = 0; column < columns; column++)
+        {
+            const ImVec2& min_max = PlotGetColumn(plot, column);
+            if (min_max.x > min_max.y)
+                continue;
+            const float t_min = 1.0f - ImSaturate((min_max.x - scale_min) * inv_scale);
+            const float t_max = 1.0f - ImSaturate((min_max.y - scale_min) * inv_scale);
+            ImVec2 pos0(inner_bb.Min.x + column * x_step, inner_bb.Min.y + height * ImMin(t_max, zero_line_t));
+            ImVec2 pos1(pos0.x + x_step, inner_bb.Min.y + height * ImMax(t_min, zero_line_t));
+            if (x_step >= 2.0f)
+                pos1.x -= 1.0f;
+            draw_list->PrimRect(pos0, pos1, column == column_hovered ? col_hovered : col_base);
+        }
+    }
+}
+
+void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 frame_size, ImGuiPlotFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    const ImGuiStyle& style = g.Style;
+    const ImGuiID id = window->GetID(label);
+
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+    if (frame_size.x == 0.0f)
+        frame_size.x = CalcItemWidth();
+    if (frame_size.y == 0.0f)
+        frame_size.y = label_size.y + (style.FramePadding.y * 2);
+
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + frame_size);
+    const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
     const ImRect total_bb(frame_bb.Min, frame_bb.Max + ImVec2(label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f, 0));
     ItemSize(total_bb, style.FramePadding.y);
     if (!ItemAdd(total_bb, 0, &frame_bb))
         return;
     const bool hovered = ItemHoverable(frame_bb, id);
 
+    // Decimate to one entry per pixel column (this also provides the scale)
+    const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
+    ImGuiPlotState* plot = NULL;
+    if ((flags & (ImGuiPlotFlags_Decimate | ImGuiPlotFlags_DecimateLTTB)) && values_count >= values_count_min && values_getter == &Plot_StreamGetter)
+        plot = PlotUpdateStream(id, (const ImGuiPlotStream*)data, ImClamp((int)inner_bb.GetWidth(), 1, ((const ImGuiPlotStream*)data)->Capacity));
+    else if ((flags & (ImGuiPlotFlags_Decimate | ImGuiPlotFlags_DecimateLTTB)) && values_count >= values_count_min)
+        plot = PlotUpdateDecimation(id, plot_type, flags, values_getter, data, values_count, values_offset % values_count, ImClamp((int)inner_bb.GetWidth(), 1, values_count));
+
     // Determine scale from values if not specified
     if (scale_min == FLT_MAX || scale_max == FLT_MAX)
     {
         float v_min = FLT_MAX;
         float v_max = -FLT_MAX;
-        for (int i = 0; i < values_count; i++)
+        ImGuiDataType data_type;
+        if (plot != NULL)
         {
-            const float v = values_getter(data, i);
-            if (v != v) // Ignore NaN values
-                continue;
-            v_min = ImMin(v_min, v);
-            v_max = ImMax(v_max, v);
+            v_min = plot->ValuesMin;
+            v_max = plot->ValuesMax;
+        }
+        else if (const void* values = PlotGetContiguousValues(values_getter, data, &data_type))
+        {
+            PlotScanMinMax(data_type, values, values_count, &v_min, &v_max);
+        }
+        else
+        {
+            for (int i = 0; i < values_count; i++)
+            {
+                const float v = values_getter(data, i);
+                if (v != v) // Ignore NaN values
+                    continue;
+                v_min = ImMin(v_min, v);
+                v_max = ImMax(v_max, v);
+            }
         }
         if (scale_min == FLT_MAX)
             scale_min = v_min;
@@ -5895,8 +7163,35 @@ void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_ge
 
     RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
 
-    const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
-    if (values_count >= values_count_min)
+    if (plot != NULL)
+    {
+        // Tooltip on hover
+        int column_hovered = -1;
+        if (hovered && inner_bb.Contains(g.IO.MousePos))
+        {
+            const float t = ImClamp((g.IO.MousePos.x - inner_bb.Min.x) / (inner_bb.Max.x - inner_bb.Min.x), 0.0f, 0.9999f);
+            if (plot->Mode == ImGuiPlotFlags_Decimate)
+            {
+                column_hovered = (plot_type == ImGuiPlotType_Lines) ? (int)(t * (plot->Columns - 1) + 0.5f) : (int)(t * plot->Columns);
+                int idx_start, idx_end;
+                PlotGetColumnRange(plot, column_hovered, &idx_start, &idx_end);
+                const ImVec2 min_max = PlotGetColumn(plot, column_hovered);
+                if (idx_end <= idx_start)
+                    column_hovered = -1;
+                else if (idx_end - idx_start == 1)
+                    SetTooltip("%d: %8.4g", idx_start, min_max.x);
+                else
+                    SetTooltip("%d..%d: %8.4g .. %8.4g", idx_start, idx_end - 1, min_max.x, min_max.y);
+            }
+            else
+            {
+                const int v_idx = (int)(t * (values_count - 1) + 0.5f);
+                SetTooltip("%d: %8.4g", v_idx, values_getter(data, (v_idx + values_offset) % values_count));
+            }
+        }
+        PlotRenderDecimated(plot_type, plot, inner_bb, scale_min, scale_max, column_hovered);
+    }
+    else if (values_count >= values_count_min)
     {
         int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
         int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
@@ -5964,41 +7259,50 @@ void ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_ge
         RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
 }
 
-struct ImGuiPlotArrayGetterData
+void ImGui::PlotLines(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride, ImGuiPlotFlags flags)
 {
-    const float* Values;
-    int Stride;
+    ImGuiPlotArrayGetterData data(values, ImGuiDataType_Float, stride);
+    PlotEx(ImGuiPlotType_Lines, label, &Plot_ArrayGetter, (void*)&data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size, flags);
+}
 
-    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
-};
+void ImGui::PlotLines(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, ImGuiPlotFlags flags)
+{
+    PlotEx(ImGuiPlotType_Lines, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size, flags);
+}
 
-static float Plot_ArrayGetter(void* data, int idx)
+void ImGui::PlotLinesScalar(const char* label, ImGuiDataType data_type, const void* p_values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride, ImGuiPlotFlags flags)
 {
-    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
-    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
-    return v;
+    ImGuiPlotArrayGetterData data(p_values, data_type, stride ? stride : (int)DataTypeGetInfo(data_type)->Size);
+    PlotEx(ImGuiPlotType_Lines, label, &Plot_ArrayGetter, (void*)&data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size, flags);
+}
+
+void ImGui::PlotLinesStream(const char* label, ImGuiPlotStream* stream, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, ImGuiPlotFlags flags)
+{
+    stream->Update();
+    PlotEx(ImGuiPlotType_Lines, label, &Plot_StreamGetter, (void*)stream, stream->GetSize(), 0, overlay_text, scale_min, scale_max, graph_size, (flags & ~ImGuiPlotFlags_DecimateLTTB) | ImGuiPlotFlags_Decimate);
 }
 
-void ImGui::PlotLines(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride)
+void ImGui::PlotHistogram(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride, ImGuiPlotFlags flags)
 {
-    ImGuiPlotArrayGetterData data(values, stride);
-    PlotEx(ImGuiPlotType_Lines, label, &Plot_ArrayGetter, (void*)&data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
+    ImGuiPlotArrayGetterData data(values, ImGuiDataType_Float, stride);
+    PlotEx(ImGuiPlotType_Histogram, label, &Plot_ArrayGetter, (void*)&data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size, flags);
 }
 
-void ImGui::PlotLines(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+void ImGui::PlotHistogram(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, ImGuiPlotFlags flags)
 {
-    PlotEx(ImGuiPlotType_Lines, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
+    PlotEx(ImGuiPlotType_Histogram, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size, flags);
 }
 
-void ImGui::PlotHistogram(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride)
+void ImGui::PlotHistogramScalar(const char* label, ImGuiDataType data_type, const void* p_values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride, ImGuiPlotFlags flags)
 {
-    ImGuiPlotArrayGetterData data(values, stride);
-    PlotEx(ImGuiPlotType_Histogram, label, &Plot_ArrayGetter, (void*)&data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
+    ImGuiPlotArrayGetterData data(p_values, data_type, stride ? stride : (int)DataTypeGetInfo(data_type)->Size);
+    PlotEx(ImGuiPlotType_Histogram, label, &Plot_ArrayGetter, (void*)&data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size, flags);
 }
 
-void ImGui::PlotHistogram(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+void ImGui::PlotHistogramStream(const char* label, ImGuiPlotStream* stream, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, ImGuiPlotFlags flags)
 {
-    PlotEx(ImGuiPlotType_Histogram, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
+    stream->Update();
+    PlotEx(ImGuiPlotType_Histogram, label, &Plot_StreamGetter, (void*)stream, stream->GetSize(), 0, overlay_text, scale_min, scale_max, graph_size, flags | ImGuiPlotFlags_Decimate);
 }
 
 //-------------------------------------------------------------------------
@@ -6424,6 +7728,8 @@ bool ImGui::MenuItem(const char* label, const char* shortcut, bool* p_selected,
 // - TabBarLayout() [Internal]
 // - TabBarCalcTabID() [Internal]
 // - TabBarCalcMaxTabWidth() [Internal]
+// - TabBarCalcFontId() [Internal]
+// - TabBarCalcTabNameSize() [Internal]
 // - TabBarFindTabById() [Internal]
 // - TabBarRemoveTab() [Internal]
 // - TabBarCloseTab() [Internal]
@@ -6439,6 +7745,8 @@ namespace ImGui
     static void             TabBarLayout(ImGuiTabBar* tab_bar);
     static ImU32            TabBarCalcTabID(ImGuiTabBar* tab_bar, const char* label);
     static float            TabBarCalcMaxTabWidth();
+    static ImGuiID          TabBarCalcFontId();
+    static ImVec2           TabBarCalcTabNameSize(ImGuiTabItem* tab, const char* label);
     static float            TabBarScrollClamp(ImGuiTabBar* tab_bar, float scrolling);
     static void             TabBarScrollToTab(ImGuiTabBar* tab_bar, ImGuiTabItem* tab);
     static ImGuiTabItem*    TabBarScrollingButtons(ImGuiTabBar* tab_bar);
@@ -6457,7 +7765,11 @@ ImGuiTabBar::ImGuiTabBar()
     ReorderRequestTabId = 0;
     ReorderRequestDir = 0;
     WantLayout = VisibleTabWasSubmitted = false;
+    WantLayoutWidths = TabsIndexDirty = true;
     LastTabItemIdx = -1;
+    LayoutFontId = 0;
+    LayoutWidthAvail = LayoutSpacing = -1.0f;
+    LayoutFlags = ImGuiTabBarFlags_None;
 }
 
 static int IMGUI_CDECL TabItemComparerByVisibleOffset(const void* lhs, const void* rhs)
@@ -6497,6 +7809,7 @@ bool    ImGui::BeginTabBar(const char* str_id, ImGuiTabBarFlags flags)
 
 bool    ImGui::BeginTabBarEx(ImGuiTabBar* tab_bar, const ImRect& tab_bar_bb, ImGuiTabBarFlags flags)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_TabBar);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
     if (window->SkipItems)
@@ -6519,7 +7832,10 @@ bool    ImGui::BeginTabBarEx(ImGuiTabBar* tab_bar, const ImRect& tab_bar_bb, ImG
     // When toggling back from ordered to manually-reorderable, shuffle tabs to enforce the last visible order.
     // Otherwise, the most recently inserted tabs would move at the end of visible list which can be a little too confusing or magic for the user.
     if ((flags & ImGuiTabBarFlags_Reorderable) && !(tab_bar->Flags & ImGuiTabBarFlags_Reorderable) && tab_bar->Tabs.Size > 1 && tab_bar->PrevFrameVisible != -1)
+    {
         ImQsort(tab_bar->Tabs.Data, tab_bar->Tabs.Size, sizeof(ImGuiTabItem), TabItemComparerByVisibleOffset);
+        tab_bar->WantLayoutWidths = tab_bar->TabsIndexDirty = true;
+    }
 
     // Flags
     if ((flags & ImGuiTabBarFlags_FittingPolicyMask_) == 0)
@@ -6549,6 +7865,7 @@ bool    ImGui::BeginTabBarEx(ImGuiTabBar* tab_bar, const ImRect& tab_bar_bb, ImG
 
 void    ImGui::EndTabBar()
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_TabBar);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
     if (window->SkipItems)
@@ -6583,6 +7900,7 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
 {
     ImGuiContext& g = *GImGui;
     tab_bar->WantLayout = false;
+    tab_bar->LastTabItemIdx = -1;
 
     // Garbage collect
     int tab_dst_n = 0;
@@ -6600,7 +7918,10 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
         tab_dst_n++;
     }
     if (tab_bar->Tabs.Size != tab_dst_n)
+    {
         tab_bar->Tabs.resize(tab_dst_n);
+        tab_bar->WantLayoutWidths = tab_bar->TabsIndexDirty = true;
+    }
 
     // Setup next selected tab
     ImGuiID scroll_track_selected_tab_id = 0;
@@ -6627,6 +7948,7 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
                 if (tab2->ID == tab_bar->SelectedTabId)
                     scroll_track_selected_tab_id = tab2->ID;
                 tab1 = tab2 = NULL;
+                tab_bar->WantLayoutWidths = tab_bar->TabsIndexDirty = true;
             }
             if (tab_bar->Flags & ImGuiTabBarFlags_SaveSettings)
                 MarkIniSettingsDirty();
@@ -6640,8 +7962,13 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
         if (ImGuiTabItem* tab_to_select = TabBarTabListPopupButton(tab_bar)) // NB: Will alter BarRect.Max.x!
             scroll_track_selected_tab_id = tab_bar->SelectedTabId = tab_to_select->ID;
 
+    // Label sizes are cached in each tab and measured again by TabItemEx() when the label changes.
+    // Measure them all here if the font changed since the last layout, so that font scaling doesn't lag.
+    const ImGuiID font_id = TabBarCalcFontId();
+    const bool font_changed = (tab_bar->LayoutFontId != font_id);
+    tab_bar->LayoutFontId = font_id;
+
     // Compute ideal widths
-    g.ShrinkWidthBuffer.resize(tab_bar->Tabs.Size);
     float width_total_contents = 0.0f;
     ImGuiTabItem* most_recently_selected_tab = NULL;
     bool found_selected_tab_id = false;
@@ -6658,54 +7985,75 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
         // Refresh tab width immediately, otherwise changes of style e.g. style.FramePadding.x would noticeably lag in the tab bar.
         // Additionally, when using TabBarAddTab() to manipulate tab bar order we occasionally insert new tabs that don't have a width yet,
         // and we cannot wait for the next BeginTabItem() call. We cannot compute this width within TabBarAddTab() because font size depends on the active window.
-        const char* tab_name = tab_bar->GetTabName(tab);
+        if (font_changed)
+            TabBarCalcTabNameSize(tab, tab_bar->GetTabName(tab));
         const bool has_close_button = (tab->Flags & ImGuiTabItemFlags_NoCloseButton) ? false : true;
-        tab->ContentWidth = TabItemCalcSize(tab_name, has_close_button).x;
+        const float content_width = TabItemCalcSize(tab->NameSize, has_close_button).x;
+        if (tab->ContentWidth != content_width)
+        {
+            tab->ContentWidth = content_width;
+            tab_bar->WantLayoutWidths = true;
+        }
 
         width_total_contents += (tab_n > 0 ? g.Style.ItemInnerSpacing.x : 0.0f) + tab->ContentWidth;
-
-        // Store data so we can build an array sorted by width if we need to shrink tabs down
-        g.ShrinkWidthBuffer[tab_n].Index = tab_n;
-        g.ShrinkWidthBuffer[tab_n].Width = tab->ContentWidth;
     }
 
-    // Compute width
+    // Widths and offsets only depend on the tabs contents widths and order, the available width and the fitting policy.
+    // Keep those of the previous frame when none of them changed, so large tab bars don't need to be shrunk down every frame.
     const float initial_offset_x = 0.0f; // g.Style.ItemInnerSpacing.x;
     const float width_avail = ImMax(tab_bar->BarRect.GetWidth() - initial_offset_x, 0.0f);
-    float width_excess = (width_avail < width_total_contents) ? (width_total_contents - width_avail) : 0.0f;
-    if (width_excess > 0.0f && (tab_bar->Flags & ImGuiTabBarFlags_FittingPolicyResizeDown))
-    {
-        // If we don't have enough room, resize down the largest tabs first
-        ShrinkWidths(g.ShrinkWidthBuffer.Data, g.ShrinkWidthBuffer.Size, width_excess);
-        for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
-            tab_bar->Tabs[g.ShrinkWidthBuffer[tab_n].Index].Width = IM_FLOOR(g.ShrinkWidthBuffer[tab_n].Width);
-    }
-    else
-    {
-        const float tab_max_width = TabBarCalcMaxTabWidth();
+    const ImGuiTabBarFlags layout_flags = (tab_bar->Flags & ImGuiTabBarFlags_FittingPolicyMask_);
+    if (tab_bar->LayoutWidthAvail != width_avail || tab_bar->LayoutSpacing != g.Style.ItemInnerSpacing.x || tab_bar->LayoutFlags != layout_flags)
+        tab_bar->WantLayoutWidths = true;
+    if (tab_bar->WantLayoutWidths)
+    {
+        tab_bar->WantLayoutWidths = false;
+        tab_bar->LayoutWidthAvail = width_avail;
+        tab_bar->LayoutSpacing = g.Style.ItemInnerSpacing.x;
+        tab_bar->LayoutFlags = layout_flags;
+
+        // Compute width
+        float width_excess = (width_avail < width_total_contents) ? (width_total_contents - width_avail) : 0.0f;
+        if (width_excess > 0.0f && (tab_bar->Flags & ImGuiTabBarFlags_FittingPolicyResizeDown))
+        {
+            // If we don't have enough room, resize down the largest tabs first
+            g.ShrinkWidthBuffer.resize(tab_bar->Tabs.Size);
+            for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
+            {
+                g.ShrinkWidthBuffer[tab_n].Index = tab_n;
+                g.ShrinkWidthBuffer[tab_n].Width = tab_bar->Tabs[tab_n].ContentWidth;
+            }
+            ShrinkWidths(g.ShrinkWidthBuffer.Data, g.ShrinkWidthBuffer.Size, width_excess);
+            for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
+                tab_bar->Tabs[g.ShrinkWidthBuffer[tab_n].Index].Width = IM_FLOOR(g.ShrinkWidthBuffer[tab_n].Width);
+        }
+        else
+        {
+            const float tab_max_width = TabBarCalcMaxTabWidth();
+            for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
+            {
+                ImGuiTabItem* tab = &tab_bar->Tabs[tab_n];
+                tab->Width = ImMin(tab->ContentWidth, tab_max_width);
+                IM_ASSERT(tab->Width > 0.0f);
+            }
+        }
+
+        // Layout all active tabs
+        float offset_x = initial_offset_x;
+        float offset_x_ideal = offset_x;
         for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
         {
             ImGuiTabItem* tab = &tab_bar->Tabs[tab_n];
-            tab->Width = ImMin(tab->ContentWidth, tab_max_width);
-            IM_ASSERT(tab->Width > 0.0f);
+            tab->Offset = offset_x;
+            offset_x += tab->Width + g.Style.ItemInnerSpacing.x;
+            offset_x_ideal += tab->ContentWidth + g.Style.ItemInnerSpacing.x;
         }
+        tab_bar->OffsetMax = ImMax(offset_x - g.Style.ItemInnerSpacing.x, 0.0f);
+        tab_bar->OffsetMaxIdeal = ImMax(offset_x_ideal - g.Style.ItemInnerSpacing.x, 0.0f);
     }
-
-    // Layout all active tabs
-    float offset_x = initial_offset_x;
-    float offset_x_ideal = offset_x;
-    tab_bar->OffsetNextTab = offset_x; // This is used by non-reorderable tab bar where the submission order is always honored.
-    for (int tab_n = 0; tab_n < tab_bar->Tabs.Size; tab_n++)
-    {
-        ImGuiTabItem* tab = &tab_bar->Tabs[tab_n];
-        tab->Offset = offset_x;
-        if (scroll_track_selected_tab_id == 0 && g.NavJustMovedToId == tab->ID)
-            scroll_track_selected_tab_id = tab->ID;
-        offset_x += tab->Width + g.Style.ItemInnerSpacing.x;
-        offset_x_ideal += tab->ContentWidth + g.Style.ItemInnerSpacing.x;
-    }
-    tab_bar->OffsetMax = ImMax(offset_x - g.Style.ItemInnerSpacing.x, 0.0f);
-    tab_bar->OffsetMaxIdeal = ImMax(offset_x_ideal - g.Style.ItemInnerSpacing.x, 0.0f);
+    tab_bar->OffsetNextTab = initial_offset_x; // This is used by non-reorderable tab bar where the submission order is always honored.
+    if (scroll_track_selected_tab_id == 0 && TabBarFindTabByID(tab_bar, g.NavJustMovedToId))
+        scroll_track_selected_tab_id = g.NavJustMovedToId;
 
     // Horizontal scrolling buttons
     const bool scrolling_buttons = (tab_bar->OffsetMax > tab_bar->BarRect.GetWidth() && tab_bar->Tabs.Size > 1) && !(tab_bar->Flags & ImGuiTabBarFlags_NoTabListScrollingButtons) && (tab_bar->Flags & ImGuiTabBarFlags_FittingPolicyScroll);
@@ -6770,20 +8118,51 @@ static float ImGui::TabBarCalcMaxTabWidth()
     return g.FontSize * 20.0f;
 }
 
+// Font identifier for the label sizes cached in ImGuiTabItem::NameSize
+static ImGuiID ImGui::TabBarCalcFontId()
+{
+    ImGuiContext& g = *GImGui;
+    return ImHashData(&g.FontSize, sizeof(g.FontSize), ImHashData(&g.Font, sizeof(g.Font)));
+}
+
+// We hash the whole label rather than using ImHashStr(), which ignores the text before "###" and would miss label changes on tabs with a fixed ID.
+static ImVec2 ImGui::TabBarCalcTabNameSize(ImGuiTabItem* tab, const char* label)
+{
+    const ImGuiID name_hash = ImHashData(label, strlen(label), TabBarCalcFontId());
+    if (tab->NameHash != name_hash)
+    {
+        tab->NameHash = name_hash;
+        tab->NameSize = CalcTextSize(label, NULL, true);
+    }
+    return tab->NameSize;
+}
+
+// Tabs are looked up through TabsIndex, which is rebuilt in one pass after tabs got removed or reordered.
 ImGuiTabItem* ImGui::TabBarFindTabByID(ImGuiTabBar* tab_bar, ImGuiID tab_id)
 {
-    if (tab_id != 0)
+    if (tab_id == 0)
+        return NULL;
+    if (tab_bar->TabsIndexDirty)
+    {
+        tab_bar->TabsIndexDirty = false;
+        tab_bar->TabsIndex.Data.resize(0);
+        tab_bar->TabsIndex.Data.reserve(tab_bar->Tabs.Size);
         for (int n = 0; n < tab_bar->Tabs.Size; n++)
-            if (tab_bar->Tabs[n].ID == tab_id)
-                return &tab_bar->Tabs[n];
-    return NULL;
+            tab_bar->TabsIndex.Data.push_back(ImGuiStorage::ImGuiStoragePair(tab_bar->Tabs[n].ID, n + 1));
+        tab_bar->TabsIndex.BuildSortByKey();
+    }
+    const int tab_n = tab_bar->TabsIndex.GetInt(tab_id, 0) - 1;
+    return (tab_n >= 0) ? &tab_bar->Tabs[tab_n] : NULL;
 }
 
 // The *TabId fields be already set by the docking system _before_ the actual TabItem was created, so we clear them regardless.
 void ImGui::TabBarRemoveTab(ImGuiTabBar* tab_bar, ImGuiID tab_id)
 {
     if (ImGuiTabItem* tab = TabBarFindTabByID(tab_bar, tab_id))
+    {
         tab_bar->Tabs.erase(tab);
+        tab_bar->WantLayoutWidths = tab_bar->TabsIndexDirty = true;
+    }
     if (tab_bar->VisibleTabId == tab_id)      { tab_bar->VisibleTabId = 0; }
     if (tab_bar->SelectedTabId == tab_id)     { tab_bar->SelectedTabId = 0; }
     if (tab_bar->NextSelectedTabId == tab_id) { tab_bar->NextSelectedTabId = 0; }
@@ -6984,6 +8363,7 @@ void    ImGui::EndTabItem()
 
 bool    ImGui::TabItemEx(ImGuiTabBar* tab_bar, const char* label, bool* p_open, ImGuiTabItemFlags flags)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_TabBar);
     // Layout whole tab bar if not already done
     if (tab_bar->WantLayout)
         TabBarLayout(tab_bar);
@@ -7011,21 +8391,28 @@ bool    ImGui::TabItemEx(ImGuiTabBar* tab_bar, const char* label, bool* p_open,
     else if (p_open == NULL)
         flags |= ImGuiTabItemFlags_NoCloseButton;
 
-    // Calculate tab contents size
-    ImVec2 size = TabItemCalcSize(label, p_open != NULL);
-
-    // Acquire tab data
-    ImGuiTabItem* tab = TabBarFindTabByID(tab_bar, id);
+    // Acquire tab data. Tabs are most often submitted in the same order as the previous frame, so check the next tab before looking up the index.
+    const int tab_next_n = tab_bar->LastTabItemIdx + 1;
+    ImGuiTabItem* tab = (tab_next_n < tab_bar->Tabs.Size && tab_bar->Tabs[tab_next_n].ID == id) ? &tab_bar->Tabs[tab_next_n] : TabBarFindTabByID(tab_bar, id);
     bool tab_is_new = false;
     if (tab == NULL)
     {
         tab_bar->Tabs.push_back(ImGuiTabItem());
         tab = &tab_bar->Tabs.back();
         tab->ID = id;
-        tab->Width = size.x;
         tab_is_new = true;
+        tab_bar->WantLayoutWidths = true;
+        if (!tab_bar->TabsIndexDirty)
+            tab_bar->TabsIndex.SetInt(id, tab_bar->Tabs.Size);
     }
     tab_bar->LastTabItemIdx = (short)tab_bar->Tabs.index_from_ptr(tab);
+
+    // Calculate tab contents size
+    ImVec2 size = TabItemCalcSize(TabBarCalcTabNameSize(tab, label), p_open != NULL);
+    if (tab_is_new)
+        tab->Width = size.x;
+    else if (tab->ContentWidth != size.x)
+        tab_bar->WantLayoutWidths = true;
     tab->ContentWidth = size.x;
 
     const bool tab_bar_appearing = (tab_bar->PrevFrameVisible + 1 < g.FrameCount);
@@ -7196,9 +8583,13 @@ void    ImGui::SetTabItemClosed(const char* label)
 }
 
 ImVec2 ImGui::TabItemCalcSize(const char* label, bool has_close_button)
+{
+    return TabItemCalcSize(CalcTextSize(label, NULL, true), has_close_button);
+}
+
+ImVec2 ImGui::TabItemCalcSize(const ImVec2& label_size, bool has_close_button)
 {
     ImGuiContext& g = *GImGui;
-    ImVec2 label_size = CalcTextSize(label, NULL, true);
     ImVec2 size = ImVec2(label_size.x + g.Style.FramePadding.x, label_size.y + g.Style.FramePadding.y * 2.0f);
     if (has_close_button)
         size.x += g.Style.FramePadding.x + (g.Style.ItemInnerSpacing.x + g.FontSize); // We use Y intentionally to fit the close button circle.
@@ -7359,9 +8750,7 @@ float ImGui::GetColumnOffset(int column_index)
         column_index = columns->Current;
     IM_ASSERT(column_index < columns->Columns.Size);
 
-    const float t = columns->Columns[column_index].OffsetNorm;
-    const float x_offset = ImLerp(columns->OffMinX, columns->OffMaxX, t);
-    return x_offset;
+    return columns->Columns[column_index].Offset;
 }
 
 static float GetColumnWidthEx(ImGuiColumns* columns, int column_index, bool before_resize = false)
@@ -7406,7 +8795,9 @@ void ImGui::SetColumnOffset(int column_index, float offset)
 
     if (!(columns->Flags & ImGuiColumnsFlags_NoForceWithinWindow))
         offset = ImMin(offset, columns->OffMaxX - g.Style.ColumnsMinSpacing * (columns->Count - column_index));
-    columns->Columns[column_index].OffsetNorm = GetColumnNormFromOffset(columns, offset - columns->OffMinX);
+    ImGuiColumnData* column = &columns->Columns[column_index];
+    column->OffsetNorm = GetColumnNormFromOffset(columns, offset - columns->OffMinX);
+    column->Offset = ImLerp(columns->OffMinX, columns->OffMaxX, column->OffsetNorm);
 
     if (preserve_width)
         SetColumnOffset(column_index + 1, offset + ImMax(g.Style.ColumnsMinSpacing, width));
@@ -7486,6 +8877,7 @@ ImGuiID ImGui::GetColumnsID(const char* str_id, int columns_count)
 
 void ImGui::BeginColumns(const char* str_id, int columns_count, ImGuiColumnsFlags flags)
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Columns);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = GetCurrentWindow();
 
@@ -7533,6 +8925,13 @@ void ImGui::BeginColumns(const char* str_id, int columns_count, ImGuiColumnsFlag
         }
     }
 
+    // Cache offsets for this frame, so NextColumn() doesn't have to compute them for every cell
+    for (int n = 0; n < columns_count + 1; n++)
+    {
+        ImGuiColumnData* column = &columns->Columns[n];
+        column->Offset = ImLerp(columns->OffMinX, columns->OffMaxX, column->OffsetNorm);
+    }
+
     for (int n = 0; n < columns_count; n++)
     {
         // Compute clipping rectangle
@@ -7575,8 +8974,6 @@ void ImGui::NextColumn()
         IM_ASSERT(columns->Current == 0);
         return;
     }
-    PopItemWidth();
-    PopClipRect();
 
     const float column_padding = g.Style.ItemSpacing.x;
     columns->LineMaxY = ImMax(columns->LineMaxY, window->DC.CursorPos.y);
@@ -7584,15 +8981,13 @@ void ImGui::NextColumn()
     {
         // Columns 1+ ignore IndentX (by canceling it out)
         // FIXME-COLUMNS: Unnecessary, could be locked?
-        window->DC.ColumnsOffset.x = GetColumnOffset(columns->Current) - window->DC.Indent.x + column_padding;
-        columns->Splitter.SetCurrentChannel(window->DrawList, columns->Current + 1);
+        window->DC.ColumnsOffset.x = columns->Columns[columns->Current].Offset - window->DC.Indent.x + column_padding;
     }
     else
     {
         // New row/line
         // Column 0 honor IndentX
         window->DC.ColumnsOffset.x = ImMax(column_padding - window->WindowPadding.x, 0.0f);
-        columns->Splitter.SetCurrentChannel(window->DrawList, 1);
         columns->Current = 0;
         columns->LineMinY = columns->LineMaxY;
     }
@@ -7601,18 +8996,35 @@ void ImGui::NextColumn()
     window->DC.CurrLineSize = ImVec2(0.0f, 0.0f);
     window->DC.CurrLineTextBaseOffset = 0.0f;
 
-    PushColumnClipRect(columns->Current);     // FIXME-COLUMNS: Could it be an overwrite?
+    // Switch to the draw channel and clip rect of the column. Rows starting below the visible area can't be seen, so we skip this
+    // until a row is visible again: the channel and clip rect then get set, whatever was used in between.
+    ImGuiColumnData* column = &columns->Columns[columns->Current];
+    if (columns->LineMinY < columns->HostClipRect.Max.y)
+    {
+        columns->Splitter.SetCurrentChannel(window->DrawList, columns->Current + 1);
+
+        // Same as PopClipRect() + PushColumnClipRect(), overwriting the clip rect so the draw list doesn't add and remove a draw command for it
+        ImDrawList* draw_list = window->DrawList;
+        const ImRect& cr = column->ClipRect;
+        draw_list->_ClipRectStack.back() = ImVec4(cr.Min.x, cr.Min.y, ImMax(cr.Min.x, cr.Max.x), ImMax(cr.Min.y, cr.Max.y));
+        draw_list->UpdateClipRect();
+        window->ClipRect = draw_list->_ClipRectStack.back();
+    }
 
+    // Same as PopItemWidth() + PushItemWidth()
     // FIXME-COLUMNS: Share code with BeginColumns() - move code on columns setup.
-    float offset_0 = GetColumnOffset(columns->Current);
-    float offset_1 = GetColumnOffset(columns->Current + 1);
+    float offset_0 = column->Offset;
+    float offset_1 = columns->Columns[columns->Current + 1].Offset;
     float width = offset_1 - offset_0;
-    PushItemWidth(width * 0.65f);
+    window->DC.ItemWidth = (width * 0.65f == 0.0f) ? window->ItemWidthDefault : width * 0.65f;
+    window->DC.ItemWidthStack.back() = window->DC.ItemWidth;
+    g.NextItemData.Flags &= ~ImGuiNextItemDataFlags_HasWidth;
     window->WorkRect.Max.x = window->Pos.x + offset_1 - column_padding;
 }
 
 void ImGui::EndColumns()
 {
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Columns);
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = GetCurrentWindow();
     ImGuiColumns* columns = window->DC.CurrentColumns;
@@ -7705,6 +9117,478 @@ void ImGui::Columns(int columns_count, const char* id, bool border)
         BeginColumns(id, columns_count, flags);
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] Widgets: ImGuiDataTable
+//-------------------------------------------------------------------------
+// - ImGuiDataTable::AddColumn(), AddRow(), SetInt(), etc.
+// - DataTableCompareRows() [Internal]
+// - DataTableSortRows() [Internal]
+// - DataTableSortTaskFunc() [Internal]
+// - ImGuiDataTable::SortBy()
+// - ImGuiDataTable::Sort()
+// - ImGuiDataTable::Draw()
+//-------------------------------------------------------------------------
+
+ImGuiDataTable::ImGuiDataTable()
+{
+    RowsCount = 0;
+    SortAsync = NULL;
+    SortAsyncUserData = NULL;
+    Version = SortedVersion = 0;
+    SortTask = NULL;
+}
+
+ImGuiDataTable::~ImGuiDataTable()
+{
+    // A sort which didn't start yet is dropped: the pending DataTableSortTaskFunc() call will free it
+    if (ImGuiDataTableSortTask* task = (ImGuiDataTableSortTask*)SortTask)
+        if (ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Pending, ImGuiAsyncTaskState_Orphaned) != ImGuiAsyncTaskState_Pending)
+        {
+            while (ImAtomicLoad(&task->State) != ImGuiAsyncTaskState_Done) {}
+            IM_FREE(task);
+        }
+    Clear();
+}
+
+void ImGuiDataTable::Clear()
+{
+    ClearRows();
+    for (int n = 0; n < Columns.Size; n++)
+        Columns[n].~ImGuiDataTableColumn();
+    Columns.clear();
+    SortSpecs.clear();
+}
+
+// An asynchronous sort in flight only uses its own copy of the values, its output will be dropped or replaced once the rows are added again
+void ImGuiDataTable::ClearRows()
+{
+    for (int n = 0; n < Columns.Size; n++)
+    {
+        ImGuiDataTableColumn& column = Columns[n];
+        column.Ints.clear();
+        column.Floats.clear();
+        column.StringOffsets.clear();
+        column.StringsBuf.clear();
+        column.StringsBufDead = 0;
+        if (column.Type == ImGuiDataTableColumnType_String)
+            column.StringsBuf.push_back(0); // Shared value of empty strings
+    }
+    RowsCount = 0;
+    SortedRows.clear();
+    Version++;
+}
+
+int ImGuiDataTable::AddColumn(const char* label, ImGuiDataTableColumnType type, const char* format)
+{
+    IM_ASSERT(RowsCount == 0 && "Add columns before rows");
+    IM_ASSERT(Columns.Size < 64);   // Maximum 64 columns, see BeginColumns()
+    Columns.push_back(ImGuiDataTableColumn());
+    ImGuiDataTableColumn& column = Columns.back();
+    column.Label = ImStrdup(label);
+    column.Format = ImStrdup(format ? format : (type == ImGuiDataTableColumnType_Float) ? "%.3f" : "%d");
+    column.Type = type;
+    if (type == ImGuiDataTableColumnType_String)
+        column.StringsBuf.push_back(0);
+    return Columns.Size - 1;
+}
+
+int ImGuiDataTable::AddRow()
+{
+    for (int n = 0; n < Columns.Size; n++)
+    {
+        ImGuiDataTableColumn& column = Columns[n];
+        switch (column.Type)
+        {
+        case ImGuiDataTableColumnType_Int:      column.Ints.push_back(0); break;
+        case ImGuiDataTableColumnType_Float:    column.Floats.push_back(0.0f); break;
+        case ImGuiDataTableColumnType_String:   column.StringOffsets.push_back(0); break;
+        }
+    }
+    Version++;
+    return RowsCount++;
+}
+
+void ImGuiDataTable::SetInt(int row, int column, int v)
+{
+    IM_ASSERT(Columns[column].Type == ImGuiDataTableColumnType_Int);
+    Columns[column].Ints[row] = v;
+    Version++;
+}
+
+void ImGuiDataTable::SetFloat(int row, int column, float v)
+{
+    IM_ASSERT(Columns[column].Type == ImGuiDataTableColumnType_Float);
+    Columns[column].Floats[row] = v;
+    Version++;
+}
+
+// Rebuild StringsBuf with only the values still referenced by a row
+static void DataTableCompactStrings(ImGuiDataTableColumn* column)
+{
+    ImVector<char> buf;
+    buf.reserve(column->StringsBuf.Size - column->StringsBufDead);
+    buf.push_back(0);
+    for (int row = 0; row < column->StringOffsets.Size; row++)
+    {
+        const int offset = column->StringOffsets[row];
+        if (offset == 0)
+            continue;
+        const int size = (int)strlen(column->StringsBuf.Data + offset) + 1;
+        column->StringOffsets[row] = buf.Size;
+        buf.resize(buf.Size + size);
+        memcpy(buf.Data + buf.Size - size, column->StringsBuf.Data + offset, (size_t)size);
+    }
+    column->StringsBuf.swap(buf);
+    column->StringsBufDead = 0;
+}
+
+// Overwrite the previous value when the new one fits, otherwise append it. Empty values all share offset 0.
+void ImGuiDataTable::SetString(int row, int column, const char* s, const char* s_end)
+{
+    ImGuiDataTableColumn& c = Columns[column];
+    IM_ASSERT(c.Type == ImGuiDataTableColumnType_String);
+    if (!s_end)
+        s_end = s + strlen(s);
+    const int len = (int)(s_end - s);
+    int offset = c.StringOffsets[row];
+    const int prev_len = (offset != 0) ? (int)strlen(c.StringsBuf.Data + offset) : 0;
+    if (len == 0)
+    {
+        if (offset != 0)
+            c.StringsBufDead += prev_len + 1;
+        offset = 0;
+    }
+    else if (offset != 0 && len <= prev_len)
+    {
+        c.StringsBufDead += prev_len - len;
+        memmove(c.StringsBuf.Data + offset, s, (size_t)len);
+        c.StringsBuf[offset + len] = 0;
+    }
+    else
+    {
+        if (offset != 0)
+            c.StringsBufDead += prev_len + 1;
+        const bool s_in_buf = (s >= c.StringsBuf.Data && s < c.StringsBuf.Data + c.StringsBuf.Size); // e.g. copying the value of another row
+        const int s_offset = s_in_buf ? (int)(s - c.StringsBuf.Data) : 0;
+        offset = c.StringsBuf.Size;
+        c.StringsBuf.resize(offset + len + 1);
+        memcpy(c.StringsBuf.Data + offset, s_in_buf ? c.StringsBuf.Data + s_offset : s, (size_t)len);
+        c.StringsBuf[offset + len] = 0;
+    }
+    c.StringOffsets[row] = offset;
+
+    // Compact once released bytes outweigh both the live bytes and the rows count, so the cost of compacting stays proportional to what it releases
+    if (c.StringsBufDead > c.StringsBuf.Size - c.StringsBufDead && c.StringsBufDead > RowsCount)
+        DataTableCompactStrings(&c);
+    Version++;
+}
+
+// Compare rows by successive keys. Rows with equal keys keep the order they were added in, as the sort is stable.
+static int DataTableCompareRows(const ImGuiDataTableSortKey* keys, int keys_count, int row_a, int row_b)
+{
+    for (int key_n = 0; key_n < keys_count; key_n++)
+    {
+        const ImGuiDataTableSortKey& key = keys[key_n];
+        int d;
+        switch (key.Type)
+        {
+        case ImGuiDataTableColumnType_Int:      { const int a = ((const int*)key.Values)[row_a], b = ((const int*)key.Values)[row_b]; d = (a > b) - (a < b); break; }
+        case ImGuiDataTableColumnType_Float:    { const float a = ((const float*)key.Values)[row_a], b = ((const float*)key.Values)[row_b]; d = (a > b) - (a < b); break; }
+        default:                                { d = strcmp(key.Strings + ((const int*)key.Values)[row_a], key.Strings + ((const int*)key.Values)[row_b]); break; }
+        }
+        if (d != 0)
+            return key.Descending ? -d : d;
+    }
+    return 0;
+}
+
+// Bottom-up merge sort of the rows indices (stable, and unlike qsort() we can pass the keys without a global)
+static void DataTableSortRows(const ImGuiDataTableSortKey* keys, int keys_count, int* rows, int* rows_temp, int rows_count)
+{
+    for (int n = 0; n < rows_count; n++)
+        rows[n] = n;
+    int* src = rows;
+    int* dst = rows_temp;
+    for (int width = 1; width < rows_count; width *= 2)
+    {
+        for (int begin = 0; begin < rows_count; begin += width * 2)
+        {
+            const int mid = ImMin(begin + width, rows_count);
+            const int end = ImMin(begin + width * 2, rows_count);
+            int i = begin, j = mid, out = begin;
+            if (mid == end || DataTableCompareRows(keys, keys_count, src[mid - 1], src[mid]) <= 0)
+            {
+                memcpy(dst + begin, src + begin, (size_t)(end - begin) * sizeof(int)); // Already in order
+                continue;
+            }
+            while (i < mid && j < end)
+                dst[out++] = (DataTableCompareRows(keys, keys_count, src[j], src[i]) < 0) ? src[j++] : src[i++];
+            while (i < mid)
+                dst[out++] = src[i++];
+            while (j < end)
+                dst[out++] = src[j++];
+        }
+        ImSwap(src, dst);
+    }
+    if (src != rows)
+        memcpy(rows, src, (size_t)rows_count * sizeof(int));
+}
+
+// Passed to SortAsync. May run on another thread: only touches the task. If ImGuiDataTable::Sort() claimed the task while waiting for us, or the table was destroyed, we don't sort (see ImGuiAsyncTaskState).
+static void DataTableSortTaskFunc(void* task_data)
+{
+    ImGuiDataTableSortTask* task = (ImGuiDataTableSortTask*)task_data;
+    const long state = ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Pending, ImGuiAsyncTaskState_Running);
+    if (state == ImGuiAsyncTaskState_Pending)
+    {
+        DataTableSortRows(task->Keys, task->KeysCount, task->Rows, task->RowsTemp, task->RowsCount);
+        ImAtomicStore(&task->State, ImGuiAsyncTaskState_Done);
+    }
+    else if (state == ImGuiAsyncTaskState_Claimed && ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Claimed, ImGuiAsyncTaskState_Done) == ImGuiAsyncTaskState_Claimed)
+    {
+        // Still being sorted by ImGuiDataTable::Sort(), which will free it
+    }
+    else
+    {
+        IM_ASSERT(ImAtomicLoad(&task->State) == ImGuiAsyncTaskState_Orphaned);
+        IM_FREE(task);
+    }
+}
+
+void ImGuiDataTable::SortBy(int column, bool descending, bool add_key)
+{
+    IM_ASSERT(column >= 0 && column < Columns.Size);
+    ImGuiDataTableSortSpec spec;
+    spec.ColumnIndex = column;
+    spec.Descending = descending;
+    if (!add_key)
+        SortSpecs.resize(0);
+    for (int n = 0; n < SortSpecs.Size; n++)
+        if (SortSpecs[n].ColumnIndex == column)
+        {
+            SortSpecs[n] = spec;
+            Version++;
+            return;
+        }
+    SortSpecs.push_back(spec);
+    Version++;
+}
+
+bool ImGuiDataTable::Sort(bool wait)
+{
+    // Collect the asynchronous sort in flight. Its rows are a valid order as long as no row was removed since.
+    // When waiting on a sort which didn't start yet, run it here instead: SortAsync may have queued it to this very thread.
+    if (SortTask != NULL)
+    {
+        ImGuiDataTableSortTask* task = (ImGuiDataTableSortTask*)SortTask;
+        const bool claimed = wait && ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Pending, ImGuiAsyncTaskState_Claimed) == ImGuiAsyncTaskState_Pending;
+        if (claimed)
+            DataTableSortRows(task->Keys, task->KeysCount, task->Rows, task->RowsTemp, task->RowsCount);
+        else
+            while (ImAtomicLoad(&task->State) != ImGuiAsyncTaskState_Done)
+                if (!wait)
+                    return false;
+        if (task->RowsCount <= RowsCount)
+        {
+            SortedRows.resize(task->RowsCount);
+            if (task->RowsCount > 0)
+                memcpy(SortedRows.Data, task->Rows, (size_t)task->RowsCount * sizeof(int));
+        }
+        SortedVersion = task->Version;
+        if (!claimed || ImAtomicCompareExchange(&task->State, ImGuiAsyncTaskState_Claimed, ImGuiAsyncTaskState_Orphaned) != ImGuiAsyncTaskState_Claimed)
+            IM_FREE(task); // Otherwise the pending DataTableSortTaskFunc() call will free it
+        SortTask = NULL;
+    }
+    if (SortedVersion == Version)
+        return true;
+
+    IMGUI_MEM_TAG_SCOPE(ImGuiMemTag_Columns);
+    if (SortSpecs.empty() || RowsCount == 0)
+    {
+        SortedRows.resize(0);
+        SortedVersion = Version;
+        return true;
+    }
+
+    // Synchronous sort, directly on the values
+    ImGuiDataTableSortKey keys[64];
+    const int keys_count = ImMin(SortSpecs.Size, IM_ARRAYSIZE(keys));
+    for (int key_n = 0; key_n < keys_count; key_n++)
+    {
+        const ImGuiDataTableColumn& column = Columns[SortSpecs[key_n].ColumnIndex];
+        keys[key_n].Type = column.Type;
+        keys[key_n].Descending = SortSpecs[key_n].Descending;
+        keys[key_n].Values = (column.Type == ImGuiDataTableColumnType_Int) ? (const void*)column.Ints.Data : (column.Type == ImGuiDataTableColumnType_Float) ? (const void*)column.Floats.Data : (const void*)column.StringOffsets.Data;
+        keys[key_n].Strings = column.StringsBuf.Data;
+    }
+    if (SortAsync == NULL)
+    {
+        ImVector<int> rows_temp;
+        rows_temp.resize(RowsCount);
+        SortedRows.resize(RowsCount);
+        DataTableSortRows(keys, keys_count, SortedRows.Data, rows_temp.Data, RowsCount);
+        SortedVersion = Version;
+        return true;
+    }
+
+    // Asynchronous sort, on a copy of the keys values so the table can be modified meanwhile
+    size_t task_size = sizeof(ImGuiDataTableSortTask) + sizeof(ImGuiDataTableSortKey) * keys_count + sizeof(int) * RowsCount * 2;
+    for (int key_n = 0; key_n < keys_count; key_n++)
+        task_size += sizeof(int) * RowsCount + ((keys[key_n].Type == ImGuiDataTableColumnType_String) ? (size_t)Columns[SortSpecs[key_n].ColumnIndex].StringsBuf.Size : 0);
+    ImGuiDataTableSortTask* task = (ImGuiDataTableSortTask*)IM_ALLOC(task_size);
+    char* p = (char*)(task + 1);
+    task->Version = Version;
+    task->RowsCount = RowsCount;
+    task->KeysCount = keys_count;
+    task->Keys = (ImGuiDataTableSortKey*)(void*)p;
+    p += sizeof(ImGuiDataTableSortKey) * keys_count;
+    task->Rows = (int*)(void*)p;
+    p += sizeof(int) * RowsCount;
+    task->RowsTemp = (int*)(void*)p;
+    p += sizeof(int) * RowsCount;
+    for (int key_n = 0; key_n < keys_count; key_n++)
+    {
+        ImGuiDataTableSortKey& key = task->Keys[key_n];
+        key = keys[key_n];
+        memcpy(p, key.Values, sizeof(int) * RowsCount);   // int, float and string offsets are all 4 bytes
+        key.Values = p;
+        p += sizeof(int) * RowsCount;
+    }
+    for (int key_n = 0; key_n < keys_count; key_n++)    // Strings last, so the values above stay aligned
+    {
+        ImGuiDataTableSortKey& key = task->Keys[key_n];
+        if (key.Type != ImGuiDataTableColumnType_String)
+            continue;
+        const ImVector<char>& strings = Columns[SortSpecs[key_n].ColumnIndex].StringsBuf;
+        memcpy(p, strings.Data, (size_t)strings.Size);
+        key.Strings = p;
+        p += strings.Size;
+    }
+    task->State = ImGuiAsyncTaskState_Pending;
+    SortTask = task;
+    SortAsync(DataTableSortTaskFunc, task, SortAsyncUserData);
+    return wait ? Sort(true) : false;
+}
+
+void ImGuiDataTable::Draw(const char* str_id, const ImVec2& size)
+{
+    ImGuiContext& g = *GImGui;
+    Sort();
+    if (!ImGui::BeginChild(str_id, size, true) || Columns.Size == 0)
+    {
+        ImGui::EndChild();
+        return;
+    }
+    ImGuiWindow* window = g.CurrentWindow;
+    const int columns_count = Columns.Size;
+    const float row_height = ImGui::GetTextLineHeightWithSpacing();
+    const float spacing_u = IM_FLOOR(g.Style.ItemSpacing.y * 0.50f);    // Same as Selectable(), so the header and rows boxes are tiled
+
+    // The header columns own the widths, restore them from the .ini settings on first use
+    const ImGuiID header_id = ImGui::GetColumnsID("##header", columns_count);
+    ImGuiColumns* header_columns = ImGui::FindOrCreateColumns(window, header_id);
+    if (header_columns->Columns.Size != columns_count + 1)
+        if (ImGuiDataTableSettings* settings = ImGui::FindDataTableSettings(header_id))
+            if (settings->ColumnsCount == columns_count)
+            {
+                header_columns->Columns.resize(0);
+                for (int n = 0; n < columns_count + 1; n++)
+                {
+                    ImGuiColumnData column;
+                    column.OffsetNorm = settings->GetOffsets()[n];
+                    header_columns->Columns.push_back(column);
+                }
+            }
+
+    // Rows, below the header. They use a copy of the header widths and are clipped to the area the header doesn't cover.
+    const ImVec2 header_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->Scroll.y);
+    window->DC.CursorPos.y += row_height;
+    ImGui::PushClipRect(ImVec2(window->ClipRect.Min.x, header_pos.y + row_height - spacing_u), window->ClipRect.Max, true);
+    ImGuiColumns* rows_columns = ImGui::FindOrCreateColumns(window, ImGui::GetColumnsID("##rows", columns_count));
+    if (header_columns->Columns.Size == columns_count + 1)
+        rows_columns->Columns = header_columns->Columns;
+    ImGui::BeginColumns("##rows", columns_count, ImGuiColumnsFlags_NoResize);
+    ImGuiListClipper clipper(RowsCount, row_height);
+    char buf[64];
+    while (clipper.Step())
+        for (int display_pos = clipper.DisplayStart; display_pos < clipper.DisplayEnd; display_pos++)
+        {
+            const int row = GetRowAt(display_pos);
+            for (int column_n = 0; column_n < columns_count; column_n++)
+            {
+                const ImGuiDataTableColumn& column = Columns[column_n];
+                switch (column.Type)
+                {
+                case ImGuiDataTableColumnType_Int:      ImGui::TextUnformatted(buf, buf + ImFormatString(buf, IM_ARRAYSIZE(buf), column.Format, column.Ints[row])); break;
+                case ImGuiDataTableColumnType_Float:    ImGui::TextUnformatted(buf, buf + ImFormatString(buf, IM_ARRAYSIZE(buf), column.Format, column.Floats[row])); break;
+                case ImGuiDataTableColumnType_String:   ImGui::TextUnformatted(column.StringsBuf.Data + column.StringOffsets[row]); break;
+                }
+                ImGui::NextColumn();
+            }
+        }
+    ImGui::EndColumns();
+    ImGui::PopClipRect();
+    const ImVec2 rows_end_pos = window->DC.CursorPos;
+
+    // Header, submitted last so it stays on top of the visible area
+    window->DC.CursorPos = header_pos;
+    window->DrawList->AddRectFilled(ImVec2(window->InnerRect.Min.x, header_pos.y - spacing_u), ImVec2(window->InnerRect.Max.x, header_pos.y + row_height - spacing_u), ImGui::GetColorU32(ImGuiCol_FrameBg));
+    ImGui::BeginColumns("##header", columns_count, ImGuiColumnsFlags_None);
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        int key_n = 0;
+        while (key_n < SortSpecs.Size && SortSpecs[key_n].ColumnIndex != column_n)
+            key_n++;
+        const bool is_key = (key_n < SortSpecs.Size);
+
+        ImGui::PushID(column_n);
+        if (ImGui::Selectable(Columns[column_n].Label))
+        {
+            // Click: sort by this column, reversing the order if it was already the primary key. Shift+Click: add or reverse a secondary key.
+            const bool add_key = g.IO.KeyShift;
+            SortBy(column_n, (is_key && (add_key || key_n == 0)) ? !SortSpecs[key_n].Descending : false, add_key);
+        }
+        ImGui::PopID();
+        if (is_key)
+        {
+            // Sort direction, preceded by the key rank when sorting by several keys
+            const float arrow_w = g.FontSize;
+            float x = window->Pos.x + ImGui::GetColumnOffset(column_n + 1) - g.Style.ItemSpacing.x - arrow_w;
+            const float y = header_pos.y;
+            if (SortSpecs.Size > 1)
+            {
+                char rank_buf[8];
+                const char* rank_end = rank_buf + ImFormatString(rank_buf, IM_ARRAYSIZE(rank_buf), "%d", key_n + 1);
+                x -= ImGui::CalcTextSize(rank_buf, rank_end).x;
+                window->DrawList->AddText(ImVec2(x, y), ImGui::GetColorU32(ImGuiCol_TextDisabled), rank_buf, rank_end);
+                x += ImGui::CalcTextSize(rank_buf, rank_end).x;
+            }
+            ImGui::RenderArrow(window->DrawList, ImVec2(x, y), ImGui::GetColorU32(ImGuiCol_Text), SortSpecs[key_n].Descending ? ImGuiDir_Down : ImGuiDir_Up, 0.70f);
+        }
+        ImGui::NextColumn();
+    }
+    ImGui::EndColumns();
+    window->DC.CursorPos = rows_end_pos;
+
+    // Save the widths once they differ from the saved ones (or from the default ones)
+    ImGuiDataTableSettings* settings = ImGui::FindDataTableSettings(header_id);
+    if (settings != NULL && settings->ColumnsCount != columns_count)
+        settings = NULL;
+    bool widths_changed = false;
+    for (int n = 1; n < columns_count && !widths_changed; n++)
+        widths_changed = (header_columns->Columns[n].OffsetNorm != (settings ? settings->GetOffsets()[n] : n / (float)columns_count));
+    if (widths_changed)
+    {
+        if (settings == NULL)
+            settings = ImGui::CreateDataTableSettings(header_id, columns_count);
+        for (int n = 0; n < columns_count + 1; n++)
+            settings->GetOffsets()[n] = header_columns->Columns[n].OffsetNorm;
+        if (ImGuiSettingsHandler* handler = ImGui::FindSettingsHandler("DataTable"))
+            ImGui::MarkIniSettingsDirty(handler);
+    }
+    ImGui::EndChild();
+}
+
 //-------------------------------------------------------------------------
 
 #endif // #ifndef IMGUI_DISABLE
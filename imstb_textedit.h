@@ -2,6 +2,8 @@
 // This is a slightly modified version of stb_textedit.h 1.13. 
 // Those changes would need to be pushed into nothings/stb:
 // - Fix in stb_textedit_discard_redo (see https://github.com/nothings/stb/issues/321)
+// - Optional STB_TEXTEDIT_FINDROW_AT_Y/STB_TEXTEDIT_FINDROW_AT_CHAR hooks, to avoid laying out every row from the start of the text
+// - Optional STB_TEXTEDIT_NO_UNDO, to compile out the built-in undo state when the user records edits on its side
 // Grep for [DEAR IMGUI] to find the changes.
 
 // stb_textedit.h - v1.13  - public domain - Sean Barrett
@@ -169,6 +171,13 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    STB_TEXTEDIT_FINDROW_AT_Y(obj,y,&start,&row_y)     [DEAR IMGUI] find the start and y position of a row at or before the
+//                                                          row straddling 'y', so the search doesn't start from the first row
+//    STB_TEXTEDIT_FINDROW_AT_CHAR(obj,n,&start,&prev_start,&row_y)  [DEAR IMGUI] find the start and y position of the row
+//                                                          containing character #n (n < length), and the start of the row before
+//                                                          it (== start for the first row)
+//    STB_TEXTEDIT_NO_UNDO               [DEAR IMGUI] compile out the fixed-size undo state and the K_UNDO/K_REDO
+//                                          handlers, for users recording edits from INSERTCHARS/DELETECHARS instead
 //
 // Todo:
 //    STB_TEXTEDIT_K_PGUP        keyboard input to move cursor up a page
@@ -310,8 +319,10 @@ typedef struct
 typedef struct
 {
    // private data
+#ifndef STB_TEXTEDIT_NO_UNDO // [DEAR IMGUI]
    StbUndoRecord          undo_rec [STB_TEXTEDIT_UNDOSTATECOUNT];
    STB_TEXTEDIT_CHARTYPE  undo_char[STB_TEXTEDIT_UNDOCHARCOUNT];
+#endif
    short undo_point, redo_point;
    int undo_char_point, redo_char_point;
 } StbUndoState;
@@ -404,6 +415,12 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
    r.ymin = r.ymax = 0;
    r.num_chars = 0;
 
+   // [DEAR IMGUI]
+   #ifdef STB_TEXTEDIT_FINDROW_AT_Y
+   if (n > 0)
+      STB_TEXTEDIT_FINDROW_AT_Y(str, y, &i, &base_y);
+   #endif
+
    // search rows to find one that straddles 'y'
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -534,6 +551,13 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
          find->y = 0;
          find->x = 0;
          find->height = 1;
+         // [DEAR IMGUI]
+         #ifdef STB_TEXTEDIT_FINDROW_AT_CHAR
+         if (z > 0) {
+            float row_y;
+            STB_TEXTEDIT_FINDROW_AT_CHAR(str, z - 1, &i, &prev_start, &row_y);
+         }
+         #endif
          while (i < z) {
             STB_TEXTEDIT_LAYOUTROW(&r, str, i);
             prev_start = i;
@@ -549,6 +573,11 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
    // search rows to find the one that straddles character n
    find->y = 0;
 
+   // [DEAR IMGUI]
+   #ifdef STB_TEXTEDIT_FINDROW_AT_CHAR
+   STB_TEXTEDIT_FINDROW_AT_CHAR(str, n, &i, &prev_start, &find->y);
+   #endif
+
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (n < i + r.num_chars)
@@ -1088,6 +1117,13 @@ retry:
 //
 // @OPTIMIZE: the undo/redo buffer should be circular
 
+#ifdef STB_TEXTEDIT_NO_UNDO // [DEAR IMGUI]
+static void stb_text_undo(STB_TEXTEDIT_STRING *str, STB_TexteditState *state) { (void)str; (void)state; }
+static void stb_text_redo(STB_TEXTEDIT_STRING *str, STB_TexteditState *state) { (void)str; (void)state; }
+static void stb_text_makeundo_insert(STB_TexteditState *state, int where, int length) { (void)state; (void)where; (void)length; }
+static void stb_text_makeundo_delete(STB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int length) { (void)str; (void)state; (void)where; (void)length; }
+static void stb_text_makeundo_replace(STB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, int new_length) { (void)str; (void)state; (void)where; (void)old_length; (void)new_length; }
+#else
 static void stb_textedit_flush_redo(StbUndoState *state)
 {
    state->redo_point = STB_TEXTEDIT_UNDOSTATECOUNT;
@@ -1334,6 +1370,7 @@ static void stb_text_makeundo_replace(STB_TEXTEDIT_STRING *str, STB_TexteditStat
          p[i] = STB_TEXTEDIT_GETCHAR(str, where+i);
    }
 }
+#endif // #ifdef STB_TEXTEDIT_NO_UNDO
 
 // reset the state to default
 static void stb_textedit_clear_state(STB_TexteditState *state, int is_single_line)
@@ -8,8 +8,10 @@
 
 // Changelog:
 // - v0.10: Initial version. Added InputText() / InputTextMultiline() calls with std::string
+// - v0.11: Grow string capacity geometrically in the resize callback. Use ImGuiInputTextFlags_ApplyOnEditOnly to only write to the string on edits.
 
 #include "imgui.h"
+#include "imgui_internal.h"     // ImInputTextResizeString()
 #include "imgui_stdlib.h"
 
 struct InputTextCallback_UserData
@@ -26,10 +28,8 @@ static int InputTextCallback(ImGuiInputTextCallbackData* data)
     {
         // Resize string callback
         // If for some reason we refuse the new length (BufTextLen) and/or capacity (BufSize) we need to set them back to what we want.
-        std::string* str = user_data->Str;
-        IM_ASSERT(data->Buf == str->c_str());
-        str->resize(data->BufTextLen);
-        data->Buf = (char*)str->c_str();
+        // See ImInputTextResizeString() for the growth policy.
+        ImInputTextResizeString(data, user_data->Str);
     }
     else if (user_data->ChainCallback)
     {
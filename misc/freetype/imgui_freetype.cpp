@@ -13,6 +13,7 @@
 // - v0.60: (2019/01/10) re-factored to match big update in STB builder. fixed texture height waste. fixed redundant glyphs when merging. support for glyph padding.
 // - v0.61: (2019/01/15) added support for imgui allocators + added FreeType only override function SetAllocatorFunctions().
 // - v0.62: (2019/02/09) added RasterizerFlags::Monochrome flag to disable font anti-aliasing (combine with ::MonoHinting for best results!)
+// - v0.63: (2020/02/24) added support for ImFontAtlas::BuildParallelFor: glyphs of each source font are rasterized as separate tasks.
 
 // Gamma Correct Blending:
 //  FreeType assumes blending in linear space rather than gamma space.
@@ -21,6 +22,7 @@
 //  The default imgui styles will be impacted by this change (alpha values will need tweaking).
 
 // FIXME: cfg.OversampleH, OversampleV are not supported (but perhaps not so necessary with this rasterizer).
+// FIXME: cfg.SignedDistanceField is not supported (glyphs are rasterized as regular coverage bitmaps).
 
 #include "imgui_freetype.h"
 #include "imgui_internal.h"     // ImMin,ImMax,ImFontAtlasBuild*,
@@ -296,6 +298,7 @@ struct ImFontBuildSrcDataFT
 {
     FreeTypeFont        Font;
     stbrp_rect*         Rects;              // Rectangle to pack. We first fill in their size and the packer will give us their position.
+    ImVector<unsigned char*> BitmapBuffers; // Temporary rasterization buffers (each of BITMAP_BUFFERS_CHUNK_SIZE bytes)
     const ImWchar*      SrcRanges;          // Ranges as requested by user (user is allowed to request too much, e.g. 0x0020..0xFFFF)
     int                 DstIndex;           // Index into atlas->Fonts[] and dst_tmp_array[]
     int                 GlyphsHighest;      // Highest requested codepoint
@@ -313,6 +316,125 @@ struct ImFontBuildDstDataFT
     ImBoolVector        GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// We could not find a way to retrieve accurate glyph size without rendering them.
+// (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
+// We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't find the temporary allocations.
+static const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
+
+static bool ImFontAtlasBuildNewFreeTypeLibrary(FT_Library* out_ft_library);
+
+// Rasterization tasks: one per source font. Each source has its own bitmap buffers, and each task writes into its own texture rectangles.
+// FT_Face objects can't be shared between threads, so when running through atlas->BuildParallelFor every task loads its own library and face.
+struct ImFontBuildTasksDataFT
+{
+    ImFontAtlas*            Atlas;
+    ImFontBuildSrcDataFT*   SrcTmpArray;
+    unsigned int            ExtraFlags;
+    bool                    UseSharedFaces;
+};
+
+static void ImFontAtlasBuildRenderTaskFT(void* task_data, int src_i)
+{
+    ImFontBuildTasksDataFT* data = (ImFontBuildTasksDataFT*)task_data;
+    ImFontBuildSrcDataFT& src_tmp = data->SrcTmpArray[src_i];
+    const ImFontConfig& cfg = data->Atlas->ConfigData[src_i];
+    if (src_tmp.GlyphsCount == 0)
+        return;
+
+    FT_Library task_ft_library = NULL;
+    FreeTypeFont task_font;
+    task_font.Face = NULL;
+    FreeTypeFont* font = &src_tmp.Font;
+    if (!data->UseSharedFaces)
+    {
+        bool font_loaded = ImFontAtlasBuildNewFreeTypeLibrary(&task_ft_library) && task_font.InitFont(task_ft_library, cfg, data->ExtraFlags);
+        IM_ASSERT(font_loaded); // Already loaded successfully from the same data in ImFontAtlasBuildWithFreeType()
+        IM_UNUSED(font_loaded);
+        font = &task_font;
+    }
+
+    // Compute multiply table if requested
+    const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+    unsigned char multiply_table[256];
+    if (multiply_enabled)
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+
+    // Gather the sizes of all rectangles we will need to pack
+    int buf_bitmap_current_used_bytes = 0;
+    src_tmp.BitmapBuffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
+    const int padding = data->Atlas->TexGlyphPadding;
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = font->LoadGlyph(src_glyph.Codepoint);
+        IM_ASSERT(metrics != NULL);
+        if (metrics == NULL)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = font->RenderGlyphAndGetInfo(&src_glyph.Info);
+        IM_ASSERT(ft_bitmap);
+
+        // Allocate new temporary chunk if needed
+        const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height;
+        if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+        {
+            buf_bitmap_current_used_bytes = 0;
+            src_tmp.BitmapBuffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
+        }
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        src_glyph.BitmapData = src_tmp.BitmapBuffers.back() + buf_bitmap_current_used_bytes;
+        buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
+        font->BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width * 1, multiply_enabled ? multiply_table : NULL);
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+    }
+
+    if (task_ft_library)
+    {
+        task_font.CloseFont();
+        FT_Done_Library(task_ft_library);
+    }
+}
+
+// Copy rasterized font characters back into the main texture, and release the temporary buffers.
+static void ImFontAtlasBuildBlitTaskFT(void* task_data, int src_i)
+{
+    ImFontBuildTasksDataFT* data = (ImFontBuildTasksDataFT*)task_data;
+    ImFontBuildSrcDataFT& src_tmp = data->SrcTmpArray[src_i];
+    ImFontAtlas* atlas = data->Atlas;
+
+    const int padding = atlas->TexGlyphPadding;
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+        stbrp_rect& pack_rect = src_tmp.Rects[glyph_i];
+        IM_ASSERT(pack_rect.was_packed);
+
+        GlyphInfo& info = src_glyph.Info;
+        IM_ASSERT(info.Width + padding <= pack_rect.w);
+        IM_ASSERT(info.Height + padding <= pack_rect.h);
+        const int tx = pack_rect.x + padding;
+        const int ty = pack_rect.y + padding;
+
+        // Blit from temporary buffer to final texture
+        size_t blit_src_stride = (size_t)src_glyph.Info.Width;
+        size_t blit_dst_stride = (size_t)atlas->TexWidth;
+        unsigned char* blit_src = src_glyph.BitmapData;
+        unsigned char* blit_dst = atlas->TexPixelsAlpha8 + (ty * blit_dst_stride) + tx;
+        for (int y = info.Height; y > 0; y--, blit_dst += blit_dst_stride, blit_src += blit_src_stride)
+            memcpy(blit_dst, blit_src, blit_src_stride);
+        src_glyph.BitmapData = NULL;
+    }
+
+    for (int buf_i = 0; buf_i < src_tmp.BitmapBuffers.Size; buf_i++)
+        IM_FREE(src_tmp.BitmapBuffers[buf_i]);
+    src_tmp.BitmapBuffers.clear();
+}
+
 bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -425,97 +547,53 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     buf_rects.resize(total_glyphs_count);
     memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
 
-    // Allocate temporary rasterization data buffers.
-    // We could not find a way to retrieve accurate glyph size without rendering them.
-    // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
-    // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't find the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     // 8. Render/rasterize font characters into the texture
-    int total_surface = 0;
     int buf_rects_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
-
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         buf_rects_out_n += src_tmp.GlyphsCount;
-
-        // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
-        {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
-
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            IM_ASSERT(metrics != NULL);
-            if (metrics == NULL)
-                continue;
-
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            IM_ASSERT(ft_bitmap);
-
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
-            {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-            }
-
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes;
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width * 1, multiply_enabled ? multiply_table : NULL);
-
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
-        }
     }
-
-    // We need a width for the skyline algorithm, any width!
-    // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
-    // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
-    const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
-    atlas->TexHeight = 0;
-    if (atlas->TexDesiredWidth > 0)
-        atlas->TexWidth = atlas->TexDesiredWidth;
-    else
-        atlas->TexWidth = (surface_sqrt >= 4096*0.7f) ? 4096 : (surface_sqrt >= 2048*0.7f) ? 2048 : (surface_sqrt >= 1024*0.7f) ? 1024 : 512;
+    ImFontBuildTasksDataFT tasks_data;
+    tasks_data.Atlas = atlas;
+    tasks_data.SrcTmpArray = src_tmp_array.Data;
+    tasks_data.ExtraFlags = extra_flags;
+    tasks_data.UseSharedFaces = (atlas->BuildParallelFor == NULL || src_tmp_array.Size <= 1);
+    ImFontAtlasBuildParallelFor(atlas, src_tmp_array.Size, ImFontAtlasBuildRenderTaskFT, &tasks_data);
+
+    // Select texture width
+    const int TEX_HEIGHT_MAX = 1024 * 32;
+    // We pack into TexWidth x TEX_HEIGHT_MAX (no inset)
+    const bool tight_packing = (atlas->Flags & ImFontAtlasFlags_TightPacking) != 0;
+    const int pack_heuristic = tight_packing ? STBRP_HEURISTIC_Skyline_BF_sortHeight : STBRP_HEURISTIC_Skyline_default;
+    ImFontAtlasBuildSelectTexWidth(atlas, buf_rects.Data, buf_rects.Size, TEX_HEIGHT_MAX, 0, pack_heuristic);
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    const int TEX_HEIGHT_MAX = 1024 * 32;
     const int num_nodes_for_packing_algorithm = atlas->TexWidth - atlas->TexGlyphPadding;
     ImVector<stbrp_node> pack_nodes;
     pack_nodes.resize(num_nodes_for_packing_algorithm);
     stbrp_context pack_context;
     stbrp_init_target(&pack_context, atlas->TexWidth, TEX_HEIGHT_MAX, pack_nodes.Data, pack_nodes.Size);
+    stbrp_setup_heuristic(&pack_context, pack_heuristic);
     ImFontAtlasBuildPackCustomRects(atlas, &pack_context);
 
     // 6. Pack each source font. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
+    // With ImFontAtlasFlags_TightPacking all sources are packed in a single call, so glyphs get sorted by height across fonts.
+    if (tight_packing)
+        stbrp_pack_rects(&pack_context, buf_rects.Data, buf_rects.Size);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
 
-        stbrp_pack_rects(&pack_context, src_tmp.Rects, src_tmp.GlyphsCount);
+        if (!tight_packing)
+            stbrp_pack_rects(&pack_context, src_tmp.Rects, src_tmp.GlyphsCount);
 
         // Extend texture height and mark missing glyphs as non-packed so we won't render them.
         // FIXME: We are not handling packing failure here (would happen if we got off TEX_HEIGHT_MAX or if a single if larger than TexWidth?)
@@ -531,6 +609,8 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
 
     // 8. Copy rasterized font characters back into the main texture
+    ImFontAtlasBuildParallelFor(atlas, src_tmp_array.Size, ImFontAtlasBuildBlitTaskFT, &tasks_data);
+
     // 9. Setup ImFont and glyphs for runtime
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
@@ -552,22 +632,10 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
         {
             ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
             stbrp_rect& pack_rect = src_tmp.Rects[glyph_i];
-            IM_ASSERT(pack_rect.was_packed);
-
             GlyphInfo& info = src_glyph.Info;
-            IM_ASSERT(info.Width + padding <= pack_rect.w);
-            IM_ASSERT(info.Height + padding <= pack_rect.h);
             const int tx = pack_rect.x + padding;
             const int ty = pack_rect.y + padding;
 
-            // Blit from temporary buffer to final texture
-            size_t blit_src_stride = (size_t)src_glyph.Info.Width;
-            size_t blit_dst_stride = (size_t)atlas->TexWidth;
-            unsigned char* blit_src = src_glyph.BitmapData;
-            unsigned char* blit_dst = atlas->TexPixelsAlpha8 + (ty * blit_dst_stride) + tx;
-            for (int y = info.Height; y > 0; y--, blit_dst += blit_dst_stride, blit_src += blit_src_stride)
-                memcpy(blit_dst, blit_src, blit_src_stride);
-
             float char_advance_x_org = info.AdvanceX;
             float char_advance_x_mod = ImClamp(char_advance_x_org, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX);
             float char_off_x = font_off_x;
@@ -590,8 +658,6 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     }
 
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         src_tmp_array[src_i].~ImFontBuildSrcDataFT();
 
@@ -643,23 +709,26 @@ static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size
     return block;
 }
 
-bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
+static FT_MemoryRec_ GImFreeTypeMemoryRec = { NULL, &FreeType_Alloc, &FreeType_Free, &FreeType_Realloc };
+
+static bool ImFontAtlasBuildNewFreeTypeLibrary(FT_Library* out_ft_library)
 {
     // FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
-    FT_MemoryRec_ memory_rec = {};
-    memory_rec.user = NULL;
-    memory_rec.alloc = &FreeType_Alloc;
-    memory_rec.free = &FreeType_Free;
-    memory_rec.realloc = &FreeType_Realloc;
-
     // https://www.freetype.org/freetype2/docs/reference/ft2-module_management.html#FT_New_Library
-    FT_Library ft_library;
-    FT_Error error = FT_New_Library(&memory_rec, &ft_library);
+    FT_Error error = FT_New_Library(&GImFreeTypeMemoryRec, out_ft_library);
     if (error != 0)
         return false;
 
     // If you don't call FT_Add_Default_Modules() the rest of code may work, but FreeType won't use our custom allocator.
-    FT_Add_Default_Modules(ft_library);
+    FT_Add_Default_Modules(*out_ft_library);
+    return true;
+}
+
+bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
+{
+    FT_Library ft_library;
+    if (!ImFontAtlasBuildNewFreeTypeLibrary(&ft_library))
+        return false;
 
     bool ret = ImFontAtlasBuildWithFreeType(ft_library, atlas, extra_flags);
     FT_Done_Library(ft_library);